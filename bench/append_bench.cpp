@@ -0,0 +1,30 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include <vector>
+
+int main() {
+    const int count = 10000000;
+
+    double ms = MeasureMs([&] {
+        ArraySequence<int> seq;
+        for (int i = 0; i < count; i++) seq.AddToEnd(i);
+        DoNotOptimize(seq.Size());
+    });
+    Report("ArraySequence<int>::AddToEnd x10M", ms, count);
+
+    ms = MeasureMs([&] {
+        ArraySequence<int> seq;
+        seq.Reserve(count);
+        for (int i = 0; i < count; i++) seq.AddToEnd(i);
+        DoNotOptimize(seq.Size());
+    });
+    Report("ArraySequence<int>::AddToEnd x10M (reserved)", ms, count);
+
+    ms = MeasureMs([&] {
+        std::vector<int> vec;
+        for (int i = 0; i < count; i++) vec.push_back(i);
+        DoNotOptimize(vec.size());
+    });
+    Report("std::vector<int>::push_back x10M (reference)", ms, count);
+    return 0;
+}
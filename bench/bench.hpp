@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Best-of-N wall time of `body` in milliseconds.
+template <typename F>
+double MeasureMs(F&& body, int repeats = 5) {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    return best;
+}
+
+inline void Report(const std::string& name, double ms, long long operations) {
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+              << std::setw(12) << std::setprecision(1) << ms * 1e6 / operations << " ns/op\n";
+}
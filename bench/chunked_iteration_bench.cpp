@@ -0,0 +1,45 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "sequence_algorithms.hpp"
+#include <numeric>
+#include <string>
+#include <vector>
+
+template <typename T>
+long long SumByIterator(const ISequence<T>& seq) {
+    long long total = 0;
+    for (const T& item : seq) total += item;
+    return total;
+}
+
+void Compare(const std::string& name, const ISequence<int>& seq) {
+    long long total = 0;
+    double ms = MeasureMs([&] { total += SumByIterator(seq); });
+    Report(name + " iterator sum @10M", ms, seq.Size());
+    ms = MeasureMs([&] { total += Sequences::Reduce(seq, 0LL, [](long long sum, int item) { return sum + item; }); });
+    Report(name + " ForEachChunk sum @10M", ms, seq.Size());
+    DoNotOptimize(total);
+}
+
+int main() {
+    const int size = 10000000;
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    ArraySequence<int> array(values.data(), size);
+    ArraySequence<int> arrayCopy(values.data(), size);
+    ListSequence<int> list(values.data(), size);
+    UnrolledListSequence<int> unrolled(values.data(), size);
+
+    Compare("ArraySequence<int>", array);
+    Compare("ListSequence<int>", list);
+    Compare("UnrolledListSequence<int>", unrolled);
+
+    bool equal = true;
+    double ms = MeasureMs([&] { equal &= array == arrayCopy; });
+    Report("ArraySequence<int> operator== @10M", ms, size);
+    ms = MeasureMs([&] { equal &= unrolled == array; });
+    Report("UnrolledListSequence<int> == ArraySequence @10M", ms, size);
+    DoNotOptimize(equal);
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include <memory>
+
+int main() {
+    const int size = 10000000;
+    const int copies = 100;
+    ArraySequence<int> seq(size);
+
+    long long before = ArraySequence<int>::BufferCopies();
+    double ms = MeasureMs([&] {
+        for (int i = 0; i < copies; i++) {
+            std::unique_ptr<ISequence<int>> copy(seq.Copy());
+            DoNotOptimize(copy->At(i));
+        }
+    });
+    Report("ArraySequence<int> Copy+read @10M", ms, copies);
+    std::cout << "  buffer copies: " << ArraySequence<int>::BufferCopies() - before << "\n";
+
+    before = ArraySequence<int>::BufferCopies();
+    ms = MeasureMs([&] {
+        for (int i = 0; i < copies / 10; i++) {
+            std::unique_ptr<ISequence<int>> copy(seq.Copy());
+            copy->AddToEnd(i);
+            DoNotOptimize(copy->Size());
+        }
+    });
+    Report("ArraySequence<int> Copy+write @10M", ms, copies / 10);
+    std::cout << "  buffer copies: " << ArraySequence<int>::BufferCopies() - before << "\n";
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "user.hpp"
+#include <string>
+
+template <typename Sequence>
+void RunUserBenchmarks(const std::string& name, int count) {
+    const std::string userName = "a user name long enough to live on the heap";
+
+    double ms = MeasureMs([&] {
+        Sequence seq;
+        for (int i = 0; i < count; i++) {
+            User user(userName, i % 100);
+            seq.AddToEnd(user);
+        }
+        DoNotOptimize(seq.Size());
+    });
+    Report(name + "<User> AddToEnd(copy)", ms, count);
+
+    ms = MeasureMs([&] {
+        Sequence seq;
+        for (int i = 0; i < count; i++) {
+            seq.EmplaceBack(userName, i % 100);
+        }
+        DoNotOptimize(seq.Size());
+    });
+    Report(name + "<User> EmplaceBack", ms, count);
+}
+
+template <typename Sequence>
+void RunStringBenchmarks(const std::string& name, int count) {
+    double ms = MeasureMs([&] {
+        Sequence seq;
+        for (int i = 0; i < count; i++) {
+            std::string value(48, 'x');
+            seq.AddToEnd(value);
+        }
+        DoNotOptimize(seq.Size());
+    });
+    Report(name + "<string> AddToEnd(copy)", ms, count);
+
+    ms = MeasureMs([&] {
+        Sequence seq;
+        for (int i = 0; i < count; i++) {
+            seq.EmplaceBack(48, 'x');
+        }
+        DoNotOptimize(seq.Size());
+    });
+    Report(name + "<string> EmplaceBack", ms, count);
+}
+
+int main() {
+    const int count = 1000000;
+    RunUserBenchmarks<ArraySequence<User>>("ArraySequence", count);
+    RunUserBenchmarks<ListSequence<User>>("ListSequence", count);
+    RunStringBenchmarks<ArraySequence<std::string>>("ArraySequence", count);
+    RunStringBenchmarks<ListSequence<std::string>>("ListSequence", count);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include <string>
+#include <vector>
+
+// The comparison operator== made before it dispatched on the concrete
+// types: chunks of one side against a cursor over the other.
+template <typename T>
+bool ChunksAgainstCursor(const ISequence<T>& first, const ISequence<T>& second) {
+    if (first.Size() != second.Size()) return false;
+    auto right = second.begin();
+    auto compare = [&](const T* items, int count) {
+        for (int i = 0; i < count; i++, ++right) {
+            if (!(items[i] == *right)) return false;
+        }
+        return true;
+    };
+    return first.ForEachChunk(ChunkVisitor<T>(compare));
+}
+
+template <typename T>
+bool ByIndex(const ISequence<T>& first, const ISequence<T>& second) {
+    if (first.Size() != second.Size()) return false;
+    for (int i = 0; i < first.Size(); i++) {
+        if (!(first.At(i) == second.At(i))) return false;
+    }
+    return true;
+}
+
+template <typename A, typename B>
+void Compare(const std::string& name, const A& first, const B& second, int size) {
+    const ISequence<typename A::value_type>& left = first;
+    const ISequence<typename A::value_type>& right = second;
+    double ms = MeasureMs([&] { DoNotOptimize(ChunksAgainstCursor(left, right)); });
+    Report(name + " chunks vs cursor", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(left == right); });
+    Report(name + " operator==", ms, size);
+}
+
+template <typename T>
+struct Array : ArraySequence<T> {
+    using value_type = T;
+    using ArraySequence<T>::ArraySequence;
+};
+
+template <typename T, typename Storage = LinkedList<T>>
+struct List : ListSequence<T, Storage> {
+    using value_type = T;
+    using ListSequence<T, Storage>::ListSequence;
+};
+
+int main() {
+    const int size = 1000000;
+    std::vector<int> ints(size);
+    std::vector<long long> longs(size);
+    std::vector<std::string> strings(size);
+    for (int i = 0; i < size; i++) {
+        ints[i] = i * 7;
+        longs[i] = i * 7LL;
+        strings[i] = "user-" + std::to_string(i % 5000) + "-name";
+    }
+
+    const int small = 10000;
+    List<int> shortList(ints.data(), small);
+    List<int> shortOther(ints.data(), small);
+    double ms = MeasureMs([&] { DoNotOptimize(ByIndex<int>(shortList, shortOther)); }, 1);
+    Report("ListSequence<int> At(i) loop @10K", ms, small);
+
+    Compare("ListSequence<int> @1M", List<int>(ints.data(), size), List<int>(ints.data(), size), size);
+    Compare("ListSequence<string> @1M", List<std::string>(strings.data(), size),
+            List<std::string>(strings.data(), size), size);
+    Compare("UnrolledList<int> @1M", List<int, UnrolledList<int>>(ints.data(), size),
+            List<int, UnrolledList<int>>(ints.data(), size), size);
+    Compare("List vs Array<int> @1M", List<int>(ints.data(), size), Array<int>(ints.data(), size), size);
+    Compare("ArraySequence<long long> @1M", Array<long long>(longs.data(), size), Array<long long>(longs.data(), size),
+            size);
+    Array<std::string> array(strings.data(), size);
+    Array<std::string> shared(array);
+    Compare("ArraySequence<string> shared @1M", array, shared, size);
+    return 0;
+}
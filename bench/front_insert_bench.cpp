@@ -0,0 +1,46 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include <string>
+#include <vector>
+
+template <typename T>
+ArraySequence<T> Prefilled(int count, const T& value) {
+    ArraySequence<T> seq;
+    seq.Reserve(count + 1024);
+    for (int i = 0; i < count; i++) seq.AddToEnd(value);
+    return seq;
+}
+
+int main() {
+    const int size = 1000000;
+    const int operations = 200;
+
+    ArraySequence<int> ints = Prefilled(size, 7);
+    double ms = MeasureMs([&] {
+        for (int i = 0; i < operations; i++) ints.AddToFront(i);
+        for (int i = 0; i < operations; i++) ints.Delete(0);
+    }, 3);
+    Report("ArraySequence<int> AddToFront+Delete(0) @1M", ms, 2 * operations);
+
+    ms = MeasureMs([&] {
+        for (int i = 0; i < operations; i++) ints.Insert(i, size / 2);
+        for (int i = 0; i < operations; i++) ints.Delete(size / 2);
+    }, 3);
+    Report("ArraySequence<int> Insert+Delete(mid) @1M", ms, 2 * operations);
+
+    std::vector<int> vec(size, 7);
+    ms = MeasureMs([&] {
+        for (int i = 0; i < operations; i++) vec.insert(vec.begin(), i);
+        for (int i = 0; i < operations; i++) vec.erase(vec.begin());
+    }, 3);
+    Report("std::vector<int> insert+erase(begin) @1M", ms, 2 * operations);
+
+    const int stringSize = size / 10;
+    ArraySequence<std::string> strings = Prefilled(stringSize, std::string(32, 's'));
+    ms = MeasureMs([&] {
+        for (int i = 0; i < operations; i++) strings.AddToFront(std::string(32, 'f'));
+        for (int i = 0; i < operations; i++) strings.Delete(0);
+    }, 3);
+    Report("ArraySequence<string> AddToFront+Delete(0) @100k", ms, 2 * operations);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "user.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+int main() {
+    const int size = 1000000;
+    std::vector<int> ints(size);
+    std::vector<double> doubles(size);
+    std::vector<std::string> strings(size);
+    std::vector<User> people;
+    people.reserve(size);
+    for (int i = 0; i < size; i++) {
+        ints[i] = i * 7;
+        doubles[i] = i * 0.5;
+        strings[i] = "user-" + std::to_string(i % 5000) + "-name";
+        people.emplace_back(strings[i], i % 100);
+    }
+
+    ArraySequence<int> intArray(ints.data(), size);
+    ListSequence<int> intList(ints.data(), size);
+    ArraySequence<double> doubleArray(doubles.data(), size);
+    ArraySequence<std::string> stringArray(strings.data(), size);
+    ArraySequence<User> userArray(people.data(), size);
+
+    double ms = MeasureMs([&] { DoNotOptimize(ArraySequence<int>(intArray).Hash()); });
+    Report("ArraySequence<int> Hash @1M", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(intList.Hash()); });
+    Report("ListSequence<int> Hash @1M", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(ArraySequence<double>(doubleArray).Hash()); });
+    Report("ArraySequence<double> Hash @1M", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(ArraySequence<std::string>(stringArray).Hash()); });
+    Report("ArraySequence<string> Hash @1M", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(ArraySequence<User>(userArray).Hash()); });
+    Report("ArraySequence<User> Hash @1M", ms, size);
+
+    // Only immutable sequences keep their hash between calls.
+    ImmutableArraySequence<int> intVersions(ints.begin(), ints.end());
+    intVersions.Hash();
+    ms = MeasureMs([&] { DoNotOptimize(intVersions.Hash()); });
+    Report("ImmutableArraySequence<int> cached Hash @1M", ms, 1);
+
+    // Two sequences that differ only in their last element.
+    ImmutableArraySequence<std::string> stringVersions(strings.begin(), strings.end());
+    std::unique_ptr<ISequence<std::string>> other(stringVersions.Set(size - 1, "different"));
+    ms = MeasureMs([&] { DoNotOptimize(stringVersions == *other); });
+    Report("ImmutableArraySequence<string> == without hashes", ms, size);
+    stringVersions.Hash();
+    other->Hash();
+    ms = MeasureMs([&] { DoNotOptimize(stringVersions == *other); });
+    Report("ImmutableArraySequence<string> == with known hashes", ms, 1);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "bench.hpp"
+#include "lazy_sequence.hpp"
+#include "sequence_algorithms.hpp"
+#include <memory>
+
+// Slice, then Where, then Map, either materialized at every step or fused
+// into one lazy pass.
+int main() {
+    const int size = 10000000;
+    ArraySequence<int> array(size);
+    for (int i = 0; i < size; i++) array.MutableAt(i) = i;
+    auto odd = [](int item) { return item % 2 == 1; };
+    auto scale = [](int item) { return item * 3; };
+
+    double ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> slice(array.Slice(size / 4, size - 1));
+        auto filtered = Sequences::Where(*slice, odd);
+        auto mapped = Sequences::Map(filtered, scale);
+        DoNotOptimize(mapped.Size());
+    });
+    Report("Eager Slice+Where+Map @10M", ms, size);
+
+    ms = MeasureMs([&] {
+        auto result = Lazy(array).Slice(size / 4, size - 1).Where(odd).Map(scale).ToArraySequence();
+        DoNotOptimize(result.Size());
+    });
+    Report("Lazy Slice+Where+Map -> ToArraySequence @10M", ms, size);
+
+    ms = MeasureMs([&] {
+        long long sum = Lazy(array).Slice(size / 4, size - 1).Where(odd).Map(scale).Reduce(
+            0LL, [](long long total, int item) { return total + item; });
+        DoNotOptimize(sum);
+    });
+    Report("Lazy Slice+Where+Map -> Reduce @10M", ms, size);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "bench.hpp"
+#include "linked_list.hpp"
+#include <string>
+
+template <typename List, typename T>
+void BuildAndDestroy(int count, const T& value) {
+    List list;
+    for (int i = 0; i < count; i++) list.Append(value);
+    DoNotOptimize(list.GetLength());
+}
+
+template <typename List, typename T>
+void Churn(int count, const T& value) {
+    List list;
+    for (int i = 0; i < count; i++) list.Append(value);
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < count / 2; i++) list.Remove(0);
+        for (int i = 0; i < count / 2; i++) list.Prepend(value);
+    }
+    DoNotOptimize(list.GetLength());
+}
+
+int main() {
+    const int nodes = 1000000;
+
+    double ms = MeasureMs([&] { BuildAndDestroy<LinkedList<int>>(nodes, 7); });
+    Report("LinkedList<int> pooled build+destroy 1M", ms, nodes);
+    ms = MeasureMs([&] { BuildAndDestroy<LinkedList<int, HeapNodeAllocator>>(nodes, 7); });
+    Report("LinkedList<int> heap build+destroy 1M", ms, nodes);
+
+    ms = MeasureMs([&] { Churn<LinkedList<int>>(nodes, 7); }, 3);
+    Report("LinkedList<int> pooled remove/prepend churn 1M", ms, 5LL * nodes);
+    ms = MeasureMs([&] { Churn<LinkedList<int, HeapNodeAllocator>>(nodes, 7); }, 3);
+    Report("LinkedList<int> heap remove/prepend churn 1M", ms, 5LL * nodes);
+
+    const std::string text(32, 's');
+    ms = MeasureMs([&] { BuildAndDestroy<LinkedList<std::string>>(nodes, text); }, 3);
+    Report("LinkedList<string> pooled build+destroy 1M", ms, nodes);
+    ms = MeasureMs([&] { BuildAndDestroy<LinkedList<std::string, HeapNodeAllocator>>(nodes, text); }, 3);
+    Report("LinkedList<string> heap build+destroy 1M", ms, nodes);
+    return 0;
+}
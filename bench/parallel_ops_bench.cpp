@@ -0,0 +1,42 @@
+#include "bench.hpp"
+#include "sequence_algorithms.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scaling of the parallel Sequences:: operations from one thread up to the
+// hardware thread count.
+int main() {
+    const int size = 100000000;
+    ArraySequence<int> array(size);
+    for (int i = 0; i < size; i++) array.MutableAt(i) = i % 1000;
+    ListSequence<int> list;
+    for (int i = 0; i < size / 10; i++) list.AddToEnd(i % 1000);
+
+    auto square = [](int item) { return item * item; };
+    auto small = [](int item) { return item < 100; };
+    auto add = [](long long sum, long long item) { return sum + item; };
+
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+
+    for (int threads : counts) {
+        Execution::ParallelPolicy policy{threads};
+        std::string suffix = " x" + std::to_string(threads) + " threads";
+
+        double ms = MeasureMs([&] { DoNotOptimize(Sequences::Map(array, square, policy).Size()); }, 3);
+        Report("ArraySequence Map @100M" + suffix, ms, size);
+
+        ms = MeasureMs([&] { DoNotOptimize(Sequences::Where(array, small, policy).Size()); }, 3);
+        Report("ArraySequence Where @100M" + suffix, ms, size);
+
+        ms = MeasureMs([&] { DoNotOptimize(Sequences::Reduce(array, 0LL, add, 0LL, policy)); }, 3);
+        Report("ArraySequence Reduce @100M" + suffix, ms, size);
+
+        ms = MeasureMs([&] { DoNotOptimize(Sequences::Reduce(list, 0LL, add, 0LL, policy)); }, 3);
+        Report("ListSequence Reduce @10M" + suffix, ms, size / 10);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "list_sequence.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Counts live heap bytes so the report can show what each version costs.
+// Every replaceable form routes through one allocate/free pair, which keeps
+// each block's size in a max_align_t-sized header in front of it.
+static long long liveBytes = 0;
+constexpr std::size_t HeaderSize = sizeof(std::max_align_t);
+
+static void* CountedAllocate(std::size_t bytes) {
+    auto* block = static_cast<unsigned char*>(std::malloc(HeaderSize + bytes));
+    if (!block) throw std::bad_alloc();
+    std::memcpy(block, &bytes, sizeof bytes);
+    liveBytes += static_cast<long long>(bytes);
+    return block + HeaderSize;
+}
+
+static void CountedFree(void* pointer) noexcept {
+    if (!pointer) return;
+    unsigned char* block = static_cast<unsigned char*>(pointer) - HeaderSize;
+    std::size_t bytes;
+    std::memcpy(&bytes, block, sizeof bytes);
+    liveBytes -= static_cast<long long>(bytes);
+    std::free(block);
+}
+
+void* operator new(std::size_t bytes) { return CountedAllocate(bytes); }
+void* operator new[](std::size_t bytes) { return CountedAllocate(bytes); }
+void operator delete(void* pointer) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer) noexcept { CountedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { CountedFree(pointer); }
+
+ISequence<int>* Edit(ISequence<int>* seq, int v) {
+    switch (v % 4) {
+        case 0: return seq->AddToFront(v);
+        case 1: return seq->AddToEnd(v);
+        case 2: return seq->Insert(v, v % 64);
+        default: return seq->Delete(v % 64);
+    }
+}
+
+// Keeps `versions` successive edits of a `size`-element sequence alive at
+// once. A mutable sequence has to be copied before every edit.
+template <typename Sequence, bool Persistent>
+void MeasureVersions(const std::string& name, int size, int versions) {
+    std::vector<int> items(size);
+    for (int i = 0; i < size; i++) items[i] = i;
+    Sequence base(items.data(), size);
+
+    long long before = liveBytes;
+    std::vector<ISequence<int>*> history;
+    history.reserve(versions);
+    ISequence<int>* current = &base;
+    double ms = MeasureMs([&] {
+        for (int v = 0; v < versions; v++) {
+            ISequence<int>* next = Persistent ? Edit(current, v) : Edit(current->Copy(), v);
+            history.push_back(next);
+            current = next;
+        }
+    }, 1);
+    long long bytes = liveBytes - before;
+    Report(name + " edits", ms, versions);
+    std::cout << "  " << versions << " versions keep " << bytes / 1024 << " KiB alive ("
+              << bytes / versions << " bytes/version)\n";
+
+    for (ISequence<int>* version : history) delete version;
+}
+
+int main() {
+    const int size = 100000;
+    MeasureVersions<ImmutableListSequence<int>, true>("ImmutableListSequence<int> @100k x1000", size, 1000);
+    // Deep copies would need ~100M nodes for 1000 versions, so measure fewer.
+    MeasureVersions<ListSequence<int>, false>("deep copy (ListSequence<int>::Copy) @100k x20", size, 20);
+    return 0;
+}
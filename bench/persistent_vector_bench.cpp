@@ -0,0 +1,60 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include <memory>
+#include <numeric>
+#include <vector>
+
+int main() {
+    const int size = 1000000;
+    const int edits = 1000;
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+
+    ImmutableArraySequence<int> persistent(values.begin(), values.end());
+    ArraySequence<int> flat(values.data(), size);
+
+    double ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> current(persistent.Copy());
+        for (int i = 0; i < edits; i++) current.reset(current->AddToEnd(i));
+        DoNotOptimize(current->Size());
+    }, 3);
+    Report("ImmutableArraySequence AddToEnd @1M", ms, edits);
+
+    ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> current(persistent.Copy());
+        for (int i = 0; i < edits; i++) current.reset(persistent.Set((i * 7919) % size, i));
+        DoNotOptimize(current->Size());
+    }, 3);
+    Report("ImmutableArraySequence Set @1M", ms, edits);
+
+    ms = MeasureMs([&] {
+        for (int i = 0; i < edits / 10; i++) {
+            std::unique_ptr<ISequence<int>> copy(flat.Copy());
+            copy->AddToEnd(i);
+            DoNotOptimize(copy->Size());
+        }
+    }, 3);
+    Report("ArraySequence Copy+AddToEnd @1M", ms, edits / 10);
+
+    ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> slice(persistent.Slice(size / 4, size - size / 4));
+        std::unique_ptr<ISequence<int>> combined(slice->Combine(&persistent));
+        DoNotOptimize(combined->Size());
+    });
+    Report("ImmutableArraySequence Slice+Combine @1M", ms, 1);
+
+    ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> slice(flat.Slice(size / 4, size - size / 4));
+        std::unique_ptr<ISequence<int>> combined(slice->Combine(&flat));
+        DoNotOptimize(combined->Size());
+    });
+    Report("ArraySequence Slice+Combine @1M", ms, 1);
+
+    long long sum = 0;
+    ms = MeasureMs([&] {
+        for (int i = 0; i < size; i += 7) sum += persistent.At(i);
+    });
+    DoNotOptimize(sum);
+    Report("ImmutableArraySequence At @1M", ms, size / 7);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "user.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+int main() {
+    const int size = 10000000;
+    const int users = 1000000;
+    std::mt19937 random(42);
+    std::vector<int> uniform(size);
+    for (int& value : uniform) value = static_cast<int>(random());
+    std::vector<int> skewed(size);
+    for (int& value : skewed) value = static_cast<int>(std::geometric_distribution<int>(0.01)(random));
+    std::vector<double> doubles(size);
+    for (double& value : doubles) value = std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+    std::vector<User> people;
+    people.reserve(users);
+    for (int i = 0; i < users; i++) {
+        people.emplace_back("user" + std::to_string(i), static_cast<int>(random() % 100));
+        people.back().id = static_cast<int>(random());
+    }
+
+    // A lambda is not std::less, so it forces the comparison sort.
+    auto compare = [](auto left, auto right) { return left < right; };
+
+    double ms = MeasureMs([&] { ArraySequence<int>(uniform.data(), size).Sort(compare); }, 3);
+    Report("ArraySequence<int> comparison sort, uniform @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<int>(uniform.data(), size).Sort(); }, 3);
+    Report("ArraySequence<int> radix sort, uniform @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<int>(skewed.data(), size).Sort(compare); }, 3);
+    Report("ArraySequence<int> comparison sort, skewed @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<int>(skewed.data(), size).Sort(); }, 3);
+    Report("ArraySequence<int> radix sort, skewed @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<double>(doubles.data(), size).Sort(compare); }, 3);
+    Report("ArraySequence<double> comparison sort @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<double>(doubles.data(), size).Sort(); }, 3);
+    Report("ArraySequence<double> radix sort @10M", ms, size);
+
+    auto byAge = [](const User& left, const User& right) { return left.age < right.age; };
+    auto byId = [](const User& left, const User& right) { return left.id < right.id; };
+    ms = MeasureMs([&] { ArraySequence<User>(people.data(), users).StableSort(byAge); }, 3);
+    Report("ArraySequence<User> comparison sort by age @1M", ms, users);
+    ms = MeasureMs([&] { ArraySequence<User>(people.data(), users).SortBy(&User::age); }, 3);
+    Report("ArraySequence<User> radix sort by age @1M", ms, users);
+    ms = MeasureMs([&] { ArraySequence<User>(people.data(), users).StableSort(byId); }, 3);
+    Report("ArraySequence<User> comparison sort by id @1M", ms, users);
+    ms = MeasureMs([&] { ArraySequence<User>(people.data(), users).SortBy(&User::id); }, 3);
+    Report("ArraySequence<User> radix sort by id @1M", ms, users);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "sequence_algorithms.hpp"
+#include "simd.hpp"
+#include <random>
+#include <vector>
+
+template <typename T>
+void Run(const char* type, const std::vector<T>& values) {
+    const int size = static_cast<int>(values.size());
+    ArraySequence<T> array(const_cast<T*>(values.data()), size);
+    ArraySequence<T> copy(array.begin(), array.end());
+    const ISequence<T>& seq = array;
+    const ISequence<T>& other = copy;
+    const T missing = T(-12345);
+    std::string prefix = std::string(type) + " ";
+
+    double ms = MeasureMs([&] {
+        T total{};
+        for (int i = 0; i < size; i++) total += seq.At(i);
+        DoNotOptimize(total);
+    });
+    Report(prefix + "sum via At()", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(Simd::Detail::ScalarSum(array.begin(), size)); });
+    Report(prefix + "sum scalar kernel", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(Sequences::Sum(array)); });
+    Report(prefix + "Sequences::Sum", ms, size);
+
+    ms = MeasureMs([&] {
+        const T* best = &seq.At(0);
+        for (int i = 1; i < size; i++) if (seq.At(i) < *best) best = &seq.At(i);
+        DoNotOptimize(best);
+    });
+    Report(prefix + "min via At()", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(Sequences::Min(seq)); });
+    Report(prefix + "Sequences::Min", ms, size);
+
+    ms = MeasureMs([&] {
+        int count = 0;
+        for (int i = 0; i < size; i++) count += seq.At(i) == values[7];
+        DoNotOptimize(count);
+    });
+    Report(prefix + "count-equal via At()", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(Sequences::Count(array, values[7])); });
+    Report(prefix + "Sequences::Count", ms, size);
+
+    ms = MeasureMs([&] {
+        int found = -1;
+        for (int i = 0; i < size; i++) if (seq.At(i) == missing) { found = i; break; }
+        DoNotOptimize(found);
+    });
+    Report(prefix + "find (absent) via At()", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(Sequences::IndexOf(seq, missing)); });
+    Report(prefix + "Sequences::IndexOf (absent)", ms, size);
+
+    ms = MeasureMs([&] {
+        bool equal = true;
+        for (int i = 0; i < size && equal; i++) equal = seq.At(i) == other.At(i);
+        DoNotOptimize(equal);
+    });
+    Report(prefix + "compare via At()", ms, size);
+    ms = MeasureMs([&] { DoNotOptimize(seq == other); });
+    Report(prefix + "operator==", ms, size);
+}
+
+int main() {
+    const int size = 10000000;
+    std::mt19937 random(42);
+    std::vector<int> ints(size);
+    for (int& value : ints) value = static_cast<int>(random() % 1000000);
+    std::vector<double> doubles(size);
+    for (double& value : doubles) value = std::uniform_real_distribution<double>(0, 1e6)(random);
+
+    Run("int @10M", ints);
+    Run("double @10M", doubles);
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include <memory>
+
+int main() {
+    const int size = 100000000;
+    ArraySequence<int> seq(size);
+
+    const int slices = 1000;
+    long long total = 0;
+    double ms = MeasureMs([&] {
+        for (int i = 0; i < slices; i++) {
+            SequenceView<int> view = seq.SliceView(i, size - 1 - i);
+            total += view.Size();
+        }
+    });
+    DoNotOptimize(total);
+    Report("ArraySequence<int> SliceView @100M", ms, slices);
+
+    ms = MeasureMs([&] {
+        std::unique_ptr<ISequence<int>> copy(seq.Slice(0, size - 1));
+        DoNotOptimize(copy->Size());
+    }, 3);
+    Report("ArraySequence<int> Slice (copy) @100M", ms, 1);
+    return 0;
+}
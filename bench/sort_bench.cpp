@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "user.hpp"
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    const int size = 10000000;
+    const int users = 1000000;
+    std::mt19937 random(42);
+    std::vector<int> ints(size);
+    for (int& value : ints) value = static_cast<int>(random());
+    std::vector<double> doubles(size);
+    for (double& value : doubles) value = std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+    std::vector<User> people;
+    people.reserve(users);
+    for (int i = 0; i < users; i++) people.emplace_back("user" + std::to_string(random() % 100000), static_cast<int>(random() % 100));
+
+    Execution::ParallelPolicy parallel{static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+    auto byAge = [](const User& left, const User& right) { return left.age < right.age; };
+
+    double ms = MeasureMs([&] { ArraySequence<int>(ints.data(), size).Sort(); }, 3);
+    Report("ArraySequence<int> Sort @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<int>(ints.data(), size).Sort(std::less<>(), parallel); }, 3);
+    Report("ArraySequence<int> Sort parallel @10M", ms, size);
+    ms = MeasureMs([&] {
+        ArraySequence<int> seq(ints.data(), size);
+        static_cast<ISequence<int>&>(seq).Sort();
+    }, 3);
+    Report("ArraySequence<int> ISequence::Sort @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<double>(doubles.data(), size).Sort(std::less<>(), parallel); }, 3);
+    Report("ArraySequence<double> Sort parallel @10M", ms, size);
+    ms = MeasureMs([&] { ArraySequence<User>(people.data(), users).StableSort(byAge, parallel); }, 3);
+    Report("ArraySequence<User> StableSort by age @1M", ms, users);
+
+    ms = MeasureMs([&] { ListSequence<int>(ints.data(), size / 10).Sort(); }, 3);
+    Report("ListSequence<int> Sort (relink) @1M", ms, size / 10);
+    ms = MeasureMs([&] { ListSequence<User>(people.data(), users).Sort(byAge); }, 3);
+    Report("ListSequence<User> Sort by age @1M", ms, users);
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "bench.hpp"
+#include "array_sequence.hpp"
+#include "list_sequence.hpp"
+#include "sequence_algorithms.hpp"
+#include <numeric>
+#include <vector>
+
+// Sums the same elements through the virtual interface and through the
+// static algorithms on the concrete type.
+template <typename T>
+long long SumThroughInterface(const ISequence<T>& seq) {
+    long long total = 0;
+    for (int i = 0; i < seq.Size(); i++) total += seq.At(i);
+    return total;
+}
+
+int main() {
+    const int size = 10000000;
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    ArraySequence<int> array(values.data(), size);
+    ListSequence<int> list(values.data(), size);
+
+    long long total = 0;
+    double ms = MeasureMs([&] { total += SumThroughInterface<int>(array); });
+    Report("ArraySequence<int> At(i) via ISequence @10M", ms, size);
+
+    ms = MeasureMs([&] {
+        const ISequence<int>& seq = array;
+        for (int item : seq) total += item;
+    });
+    Report("ArraySequence<int> ISequence iterator @10M", ms, size);
+
+    ms = MeasureMs([&] { total += Sequences::Reduce(array, 0LL, [](long long sum, int item) { return sum + item; }); });
+    Report("ArraySequence<int> Sequences::Reduce @10M", ms, size);
+
+    ms = MeasureMs([&] {
+        const ISequence<int>& seq = list;
+        for (int item : seq) total += item;
+    });
+    Report("ListSequence<int> ISequence iterator @10M", ms, size);
+
+    ms = MeasureMs([&] { total += Sequences::Reduce(list, 0LL, [](long long sum, int item) { return sum + item; }); });
+    Report("ListSequence<int> Sequences::Reduce @10M", ms, size);
+    DoNotOptimize(total);
+    return 0;
+}
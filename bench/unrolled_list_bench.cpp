@@ -0,0 +1,36 @@
+#include "bench.hpp"
+#include "list_sequence.hpp"
+
+template <typename Sequence>
+void RunSuite(const std::string& name, int size) {
+    Sequence seq;
+    for (int i = 0; i < size; i++) seq.AddToEnd(i);
+
+    const int lookups = 2000;
+    long long sum = 0;
+    double ms = MeasureMs([&] {
+        for (int i = 0; i < lookups; i++) sum += seq.At(static_cast<int>((i * 7919LL) % size));
+    }, 3);
+    DoNotOptimize(sum);
+    Report(name + " At(random)", ms, lookups);
+
+    const int edits = 2000;
+    ms = MeasureMs([&] {
+        for (int i = 0; i < edits; i++) seq.Insert(i, size / 2);
+        for (int i = 0; i < edits; i++) seq.Delete(size / 2);
+    }, 3);
+    Report(name + " Insert+Delete(mid)", ms, 2 * edits);
+
+    ms = MeasureMs([&] {
+        for (int value : seq) sum += value;
+    });
+    DoNotOptimize(sum);
+    Report(name + " iterate", ms, size);
+}
+
+int main() {
+    const int size = 100000;
+    RunSuite<ListSequence<int>>("ListSequence<int> @100k", size);
+    RunSuite<UnrolledListSequence<int>>("UnrolledListSequence<int> @100k", size);
+    return 0;
+}
@@ -2,111 +2,218 @@
 #define ARRAY_SEQUENCE_HPP
 
 #include "dynamic_array.hpp"
+#include "persistent_vector.hpp"
+#include "sequence_view.hpp"
 #include "sequence.hpp"
+#include "sort.hpp"
 #include <algorithm>
-
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// The buffer is reference counted and copy-on-write: copies of the sequence
+// and views from SliceView share it, and the first write through a shared
+// buffer copies it. A null buffer means empty, which keeps moves noexcept.
 template <typename T>
 class ArraySequence : public ISequence<T> {
 protected:
-    DynamicArray<T>* array;
-    int capacity;
+    std::shared_ptr<DynamicArray<T>> array;
+    inline static std::atomic<long long> bufferCopies{0};
+    const DynamicArray<T>& Items() const;
+    DynamicArray<T>& Mutable(int minimumCapacity = 0);
     void EnsureCapacity(int newCapacity);
+    std::unique_ptr<typename ISequence<T>::Cursor> CreateCursor() const override;
 
 public:
     ArraySequence();
     ArraySequence(int size);
     ArraySequence(T* items, int size);
+    template <typename InputIt, EnableIfIterator<InputIt> = 0>
+    ArraySequence(InputIt first, InputIt last);
     ArraySequence(const ArraySequence<T>& other);
-    ~ArraySequence() override;
+    ArraySequence(ArraySequence<T>&& other) noexcept;
+    ~ArraySequence() override = default;
 
     ArraySequence<T>& operator=(const ArraySequence<T>& other);
+    ArraySequence<T>& operator=(ArraySequence<T>&& other) noexcept;
 
     void Reserve(int newCapacity);
 
-    T Front() const override;
-    T Back() const override;
-    T At(int index) const override;
+    const T& Front() const final;
+    const T& Back() const final;
+    const T& At(int index) const final;
+    // Writable references; plain reads go through the const accessors and
+    // never copy a shared buffer.
+    T& MutableFront();
+    T& MutableBack();
+    T& MutableAt(int index);
     ISequence<T>* AddToEnd(T item) override;
     ISequence<T>* AddToFront(T item) override;
     ISequence<T>* Insert(T item, int index) override;
     ISequence<T>* Delete(int index) override;
+    ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int index) override;
+    ISequence<T>* AddRange(const T* items, int count) override;
+    ISequence<T>* AddRange(const ISequence<T>* other) override;
+    ISequence<T>* InsertRange(const T* items, int count, int index) override;
     ISequence<T>* Slice(int start, int end) const override;
     ISequence<T>* Combine(const ISequence<T>* other) const override;
-    int Size() const override;
+    int Size() const final;
+    bool ForEachChunk(const ChunkVisitor<T>& visit) const override;
+    bool Equals(const ISequence<T>* other) const override;
+    const Hashing::Fingerprint* CachedFingerprint() const override;
+    ISequence<T>* SortWith(const ElementComparer<T>& less) override;
+    ISequence<T>* StableSortWith(const ElementComparer<T>& less) override;
     ISequence<T>* GetReference() override;
     ISequence<T>* Copy() const override;
 
+    // Hide the ISequence versions so a known comparator inlines. With a
+    // ParallelPolicy the buffer is sorted and merged by several threads.
+    template <typename Less = std::less<>, typename Policy = Execution::SequencedPolicy>
+    ISequence<T>* Sort(const Less& less = Less(), const Policy& policy = Policy());
+    template <typename Less = std::less<>, typename Policy = Execution::SequencedPolicy>
+    ISequence<T>* StableSort(const Less& less = Less(), const Policy& policy = Policy());
+
+    // Stable sort by key(element): a callable or a pointer to member such as
+    // &User::age. Integral and floating-point keys are radix sorted.
+    template <typename KeyOf, typename Policy = Execution::SequencedPolicy>
+    ISequence<T>* SortBy(const KeyOf& key, const Policy& policy = Policy());
+
     int Capacity() const;
+    SequenceView<T> SliceView(int start, int end) const;
+
+    // Number of buffers copied because a shared one was written to.
+    static long long BufferCopies();
+
+    const T* begin() const;
+    const T* end() const;
 };
 
+// Persistent array: every "modifying" call returns a new sequence that shares
+// all untouched trie nodes with this one, so edits, Slice and Combine are
+// O(log n) instead of full copies.
 template <typename T>
-class ImmutableArraySequence : public ArraySequence<T> {
+class ImmutableArraySequence : public ISequence<T> {
+protected:
+    PersistentVector<T> vector;
+    Hashing::Fingerprint fingerprint;
+
+    class VectorCursor : public ISequence<T>::Cursor {
+        typename PersistentVector<T>::ConstIterator current;
+
+    public:
+        explicit VectorCursor(typename PersistentVector<T>::ConstIterator current) : current(current) {}
+        const T& Current() const override { return *current; }
+        void Next() override { ++current; }
+        std::unique_ptr<typename ISequence<T>::Cursor> Clone() const override {
+            return std::make_unique<VectorCursor>(*this);
+        }
+    };
+
+    std::unique_ptr<typename ISequence<T>::Cursor> CreateCursor() const override;
+    ImmutableArraySequence<T>* With(PersistentVector<T> edited) const;
+
 public:
-    ImmutableArraySequence(const ArraySequence<T>& seq) : ArraySequence<T>(seq) {}
+    ImmutableArraySequence();
+    ImmutableArraySequence(T* items, int size);
+    template <typename InputIt, EnableIfIterator<InputIt> = 0>
+    ImmutableArraySequence(InputIt first, InputIt last);
+    explicit ImmutableArraySequence(const ArraySequence<T>& seq);
+    explicit ImmutableArraySequence(PersistentVector<T> vector) noexcept;
+
+    const T& Front() const final;
+    const T& Back() const final;
+    const T& At(int index) const final;
+    int Size() const final;
+    bool ForEachChunk(const ChunkVisitor<T>& visit) const override;
+    bool Equals(const ISequence<T>* other) const override;
+    const Hashing::Fingerprint* CachedFingerprint() const override;
+    ISequence<T>* Slice(int start, int end) const override;
+    ISequence<T>* Combine(const ISequence<T>* other) const override;
     ISequence<T>* AddToEnd(T item) override;
     ISequence<T>* AddToFront(T item) override;
     ISequence<T>* Insert(T item, int index) override;
     ISequence<T>* Delete(int index) override;
+    ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int index) override;
+    ISequence<T>* AddRange(const T* items, int count) override;
+    ISequence<T>* AddRange(const ISequence<T>* other) override;
+    ISequence<T>* InsertRange(const T* items, int count, int index) override;
+    ISequence<T>* SortWith(const ElementComparer<T>& less) override;
+    ISequence<T>* StableSortWith(const ElementComparer<T>& less) override;
     ISequence<T>* GetReference() override;
     ISequence<T>* Copy() const override;
+
+    ISequence<T>* Set(int index, T item) const;
+
+    typename PersistentVector<T>::ConstIterator begin() const;
+    typename PersistentVector<T>::ConstIterator end() const;
 };
 
 template <typename T>
-ArraySequence<T>::ArraySequence() : array(new DynamicArray<T>(0)), capacity(1) {}
+ArraySequence<T>::ArraySequence() : array() {}
 
 template <typename T>
-ArraySequence<T>::ArraySequence(int size) : array(new DynamicArray<T>(size)), capacity(size) {
-    if (size < 0) throw Errors::InvalidSize();
+ArraySequence<T>::ArraySequence(int size) : array(std::make_shared<DynamicArray<T>>(size)) {}
+
+template <typename T>
+ArraySequence<T>::ArraySequence(T* items, int size) : array(std::make_shared<DynamicArray<T>>(items, size)) {}
+
+template <typename T>
+template <typename InputIt, EnableIfIterator<InputIt>>
+ArraySequence<T>::ArraySequence(InputIt first, InputIt last) : array() {
+    Mutable().AppendRange(first, last);
 }
 
 template <typename T>
-ArraySequence<T>::ArraySequence(T* items, int size) : array(new DynamicArray<T>(items, size)), capacity(size) {
-    if (size < 0) throw Errors::InvalidSize();
+ArraySequence<T>::ArraySequence(const ArraySequence<T>& other) : array(other.array) {}
+
+template <typename T>
+ArraySequence<T>::ArraySequence(ArraySequence<T>&& other) noexcept : array(std::move(other.array)) {}
+
+template <typename T>
+ArraySequence<T>& ArraySequence<T>::operator=(const ArraySequence<T>& other) {
+    array = other.array;
+    return *this;
 }
 
 template <typename T>
-ArraySequence<T>::ArraySequence(const ArraySequence<T>& other) 
-    : array(new DynamicArray<T>(*other.array)), capacity(other.capacity) {}
+ArraySequence<T>& ArraySequence<T>::operator=(ArraySequence<T>&& other) noexcept {
+    array = std::move(other.array);
+    return *this;
+}
 
 template <typename T>
-ArraySequence<T>::~ArraySequence() {
-    delete array;
+const DynamicArray<T>& ArraySequence<T>::Items() const {
+    static const DynamicArray<T> empty;
+    return array ? *array : empty;
 }
 
+// Gives this sequence a buffer of its own, copying it if anyone shares it.
 template <typename T>
-ArraySequence<T>& ArraySequence<T>::operator=(const ArraySequence<T>& other) {
-    if (this != &other) {
-        DynamicArray<T>* newArray = nullptr;
-        try {
-            newArray = new DynamicArray<T>(*other.array);
-            delete array;
-            array = newArray;
-            capacity = other.capacity;
-        } catch (...) {
-            delete newArray;
-            throw;
-        }
+DynamicArray<T>& ArraySequence<T>::Mutable(int minimumCapacity) {
+    if (!array) {
+        array = std::make_shared<DynamicArray<T>>();
+    } else if (array.use_count() > 1) {
+        auto copy = std::make_shared<DynamicArray<T>>();
+        copy->Reserve(std::max(array->GetCapacity(), minimumCapacity));
+        copy->AppendRange(array->GetData(), array->GetData() + array->GetSize());
+        array = std::move(copy);
+        bufferCopies++;
     }
-    return *this;
+    return *array;
 }
 
 template <typename T>
 void ArraySequence<T>::EnsureCapacity(int newCapacity) {
+    DynamicArray<T>& items = Mutable(newCapacity);
+    int capacity = items.GetCapacity();
     if (newCapacity <= capacity) return;
-    capacity = std::max(newCapacity, capacity * 2);
-    DynamicArray<T>* newArray = nullptr;
-    try {
-        newArray = new DynamicArray<T>(capacity);
-        for (int i = 0; i < array->GetSize(); i++) {
-            newArray->Set(i, array->Get(i));
-        }
-        newArray->Resize(array->GetSize());
-        delete array;
-        array = newArray;
-    } catch (...) {
-        delete newArray;
-        throw;
-    }
+    items.Reserve(std::max(newCapacity, capacity * 2));
 }
 
 template <typename T>
@@ -116,89 +223,196 @@ void ArraySequence<T>::Reserve(int newCapacity) {
 }
 
 template <typename T>
-T ArraySequence<T>::Front() const {
-    if (array->GetSize() == 0) throw Errors::EmptyContainer();
+const T& ArraySequence<T>::Front() const {
+    if (Size() == 0) throw Errors::EmptyContainer();
     return array->Get(0);
 }
 
 template <typename T>
-T ArraySequence<T>::Back() const {
-    if (array->GetSize() == 0) throw Errors::EmptyContainer();
+const T& ArraySequence<T>::Back() const {
+    if (Size() == 0) throw Errors::EmptyContainer();
     return array->Get(array->GetSize() - 1);
 }
 
 template <typename T>
-T ArraySequence<T>::At(int index) const {
-    if (index < 0 || index >= array->GetSize()) throw Errors::IndexOutOfRange();
+const T& ArraySequence<T>::At(int index) const {
+    if (index < 0 || index >= Size()) throw Errors::IndexOutOfRange();
     return array->Get(index);
 }
 
+// Writable references first detach a buffer shared with copies or views.
+template <typename T>
+T& ArraySequence<T>::MutableFront() {
+    if (Size() == 0) throw Errors::EmptyContainer();
+    return Mutable().Get(0);
+}
+
+template <typename T>
+T& ArraySequence<T>::MutableBack() {
+    if (Size() == 0) throw Errors::EmptyContainer();
+    DynamicArray<T>& items = Mutable();
+    return items.Get(items.GetSize() - 1);
+}
+
+template <typename T>
+T& ArraySequence<T>::MutableAt(int index) {
+    if (index < 0 || index >= Size()) throw Errors::IndexOutOfRange();
+    return Mutable().Get(index);
+}
+
 template <typename T>
 ISequence<T>* ArraySequence<T>::AddToEnd(T item) {
-    EnsureCapacity(array->GetSize() + 1);
-    array->Resize(array->GetSize() + 1);
-    array->Set(array->GetSize() - 1, item);
+    EnsureCapacity(Size() + 1);
+    array->PushBack(std::move(item));
     return this;
 }
 
 template <typename T>
 ISequence<T>* ArraySequence<T>::AddToFront(T item) {
-    EnsureCapacity(array->GetSize() + 1);
-    array->Resize(array->GetSize() + 1);
-    for (int i = array->GetSize() - 1; i > 0; i--) {
-        array->Set(i, array->Get(i - 1));
-    }
-    array->Set(0, item);
+    EnsureCapacity(Size() + 1);
+    array->Insert(0, std::move(item));
     return this;
 }
 
 template <typename T>
 ISequence<T>* ArraySequence<T>::Insert(T item, int index) {
-    if (index < 0 || index > array->GetSize()) throw Errors::IndexOutOfRange();
-    EnsureCapacity(array->GetSize() + 1);
-    array->Resize(array->GetSize() + 1);
-    for (int i = array->GetSize() - 1; i > index; i--) {
-        array->Set(i, array->Get(i - 1));
-    }
-    array->Set(index, item);
+    if (index < 0 || index > Size()) throw Errors::IndexOutOfRange();
+    EnsureCapacity(Size() + 1);
+    array->Insert(index, std::move(item));
     return this;
 }
 
 template <typename T>
 ISequence<T>* ArraySequence<T>::Delete(int index) {
-    if (index < 0 || index >= array->GetSize()) throw Errors::IndexOutOfRange();
-    for (int i = index; i < array->GetSize() - 1; i++) {
-        array->Set(i, array->Get(i + 1));
+    if (index < 0 || index >= Size()) throw Errors::IndexOutOfRange();
+    Mutable().Remove(index);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::EmplaceBackWith(const ElementConstructor<T>& construct) {
+    Mutable().AppendWith(construct);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::EmplaceFrontWith(const ElementConstructor<T>& construct) {
+    Mutable().InsertAtWith(construct, 0);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::EmplaceAtWith(const ElementConstructor<T>& construct, int index) {
+    Mutable().InsertAtWith(construct, index);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::AddRange(const T* items, int count) {
+    if (count < 0) throw Errors::NegativeCount();
+    Mutable().AppendRange(items, items + count);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::AddRange(const ISequence<T>* other) {
+    DynamicArray<T>& target = Mutable();
+    if (const auto* otherArray = dynamic_cast<const ArraySequence<T>*>(other)) {
+        const DynamicArray<T>& source = otherArray->Items();
+        target.AppendRange(source.GetData(), source.GetData() + source.GetSize());
+        return this;
+    }
+    EnsureCapacity(Size() + other->Size());
+    for (const T& item : *other) {
+        target.PushBack(item);
     }
-    array->Resize(array->GetSize() - 1);
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::InsertRange(const T* items, int count, int index) {
+    if (count < 0) throw Errors::NegativeCount();
+    Mutable().InsertRange(index, items, items + count);
     return this;
 }
 
 template <typename T>
 ISequence<T>* ArraySequence<T>::Slice(int start, int end) const {
-    if (start < 0 || end > array->GetSize() || start > end) throw Errors::IndexOutOfRange();
-    ArraySequence<T>* result = new ArraySequence<T>();
-    result->EnsureCapacity(end - start);
-    result->array->Resize(end - start);
-    for (int i = start; i < end; i++) {
-        result->array->Set(i - start, array->Get(i));
-    }
-    return result;
+    if (start < 0 || end >= Size() || start > end) throw Errors::IndexOutOfRange();
+    const T* items = array->GetData();
+    return new ArraySequence<T>(items + start, items + end + 1);
 }
 
 template <typename T>
 ISequence<T>* ArraySequence<T>::Combine(const ISequence<T>* other) const {
-    ArraySequence<T>* result = new ArraySequence<T>(*this);
-    result->EnsureCapacity(array->GetSize() + other->Size());
-    for (int i = 0; i < other->Size(); i++) {
-        result->AddToEnd(other->At(i));
-    }
+    ArraySequence<T>* result = new ArraySequence<T>();
+    result->Reserve(Size() + other->Size());
+    result->array->AppendRange(begin(), end());
+    result->AddRange(other);
     return result;
 }
 
 template <typename T>
 int ArraySequence<T>::Size() const {
-    return array->GetSize();
+    return array ? array->GetSize() : 0;
+}
+
+template <typename T>
+bool ArraySequence<T>::ForEachChunk(const ChunkVisitor<T>& visit) const {
+    return Size() == 0 || visit(array->GetData(), Size());
+}
+
+// References from MutableAt stay writable after Hash(), so nothing is cached.
+template <typename T>
+const Hashing::Fingerprint* ArraySequence<T>::CachedFingerprint() const {
+    return nullptr;
+}
+
+template <typename T>
+bool ArraySequence<T>::Equals(const ISequence<T>* other) const {
+    if (const auto* otherArray = dynamic_cast<const ArraySequence<T>*>(other)) {
+        if (array == otherArray->array) return true;
+        if (Size() != otherArray->Size()) return false;
+        return Size() == 0 || ISequence<T>::EqualRuns(array->GetData(), otherArray->array->GetData(), Size());
+    }
+    return this->EqualElements(other);
+}
+
+template <typename T>
+template <typename Less, typename Policy>
+ISequence<T>* ArraySequence<T>::Sort(const Less& less, const Policy& policy) {
+    if (Size() > 1) Sorting::SortRange(Mutable().GetData(), Size(), less, false, Execution::PartCount(policy, Size()));
+    return this;
+}
+
+template <typename T>
+template <typename Less, typename Policy>
+ISequence<T>* ArraySequence<T>::StableSort(const Less& less, const Policy& policy) {
+    if (Size() > 1) Sorting::SortRange(Mutable().GetData(), Size(), less, true, Execution::PartCount(policy, Size()));
+    return this;
+}
+
+template <typename T>
+template <typename KeyOf, typename Policy>
+ISequence<T>* ArraySequence<T>::SortBy(const KeyOf& key, const Policy& policy) {
+    if (Size() > 1) Sorting::SortRangeBy(Mutable().GetData(), Size(), key, Execution::PartCount(policy, Size()));
+    return this;
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::SortWith(const ElementComparer<T>& less) {
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) return Sort();
+    }
+    return Sort(less);
+}
+
+template <typename T>
+ISequence<T>* ArraySequence<T>::StableSortWith(const ElementComparer<T>& less) {
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) return StableSort();
+    }
+    return StableSort(less);
 }
 
 template <typename T>
@@ -213,40 +427,210 @@ ISequence<T>* ArraySequence<T>::Copy() const {
 
 template <typename T>
 int ArraySequence<T>::Capacity() const {
-    return capacity;
+    return array ? array->GetCapacity() : 0;
+}
+
+template <typename T>
+SequenceView<T> ArraySequence<T>::SliceView(int start, int end) const {
+    if (start < 0 || end >= Size() || start > end) throw Errors::IndexOutOfRange();
+    return SequenceView<T>(array, start, end - start + 1);
+}
+
+template <typename T>
+long long ArraySequence<T>::BufferCopies() {
+    return bufferCopies.load();
+}
+
+template <typename T>
+const T* ArraySequence<T>::begin() const {
+    return Items().GetData();
+}
+
+template <typename T>
+const T* ArraySequence<T>::end() const {
+    return Items().GetData() + Size();
+}
+
+template <typename T>
+std::unique_ptr<typename ISequence<T>::Cursor> ArraySequence<T>::CreateCursor() const {
+    return std::make_unique<typename ISequence<T>::PointerCursor>(Items().GetData());
+}
+
+template <typename T>
+ImmutableArraySequence<T>::ImmutableArraySequence() : vector() {}
+
+template <typename T>
+ImmutableArraySequence<T>::ImmutableArraySequence(T* items, int size) : vector() {
+    if (size < 0) throw Errors::InvalidSize();
+    vector = PersistentVector<T>(items, items + size);
+}
+
+template <typename T>
+template <typename InputIt, EnableIfIterator<InputIt>>
+ImmutableArraySequence<T>::ImmutableArraySequence(InputIt first, InputIt last) : vector(first, last) {}
+
+template <typename T>
+ImmutableArraySequence<T>::ImmutableArraySequence(const ArraySequence<T>& seq) : vector(seq.begin(), seq.end()) {}
+
+template <typename T>
+ImmutableArraySequence<T>::ImmutableArraySequence(PersistentVector<T> vector) noexcept : vector(std::move(vector)) {}
+
+template <typename T>
+ImmutableArraySequence<T>* ImmutableArraySequence<T>::With(PersistentVector<T> edited) const {
+    return new ImmutableArraySequence<T>(std::move(edited));
+}
+
+template <typename T>
+const T& ImmutableArraySequence<T>::Front() const {
+    if (vector.GetSize() == 0) throw Errors::EmptyContainer();
+    return vector.Get(0);
+}
+
+template <typename T>
+const T& ImmutableArraySequence<T>::Back() const {
+    if (vector.GetSize() == 0) throw Errors::EmptyContainer();
+    return vector.Get(vector.GetSize() - 1);
+}
+
+template <typename T>
+const T& ImmutableArraySequence<T>::At(int index) const {
+    return vector.Get(index);
+}
+
+template <typename T>
+int ImmutableArraySequence<T>::Size() const {
+    return vector.GetSize();
+}
+
+template <typename T>
+bool ImmutableArraySequence<T>::ForEachChunk(const ChunkVisitor<T>& visit) const {
+    return vector.ForEachChunk(visit);
+}
+
+template <typename T>
+const Hashing::Fingerprint* ImmutableArraySequence<T>::CachedFingerprint() const {
+    return &fingerprint;
+}
+
+template <typename T>
+bool ImmutableArraySequence<T>::Equals(const ISequence<T>* other) const {
+    if (const auto* otherArray = dynamic_cast<const ImmutableArraySequence<T>*>(other)) {
+        if (vector.SharesContents(otherArray->vector)) return true;
+        if (Size() != otherArray->Size()) return false;
+        return std::equal(vector.begin(), vector.end(), otherArray->vector.begin(), ISequence<T>::Same);
+    }
+    return this->EqualElements(other);
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::Slice(int start, int end) const {
+    if (start < 0 || end >= vector.GetSize() || start > end) throw Errors::IndexOutOfRange();
+    return With(vector.Slice(start, end));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::Combine(const ISequence<T>* other) const {
+    if (const auto* otherArray = dynamic_cast<const ImmutableArraySequence<T>*>(other)) {
+        return With(PersistentVector<T>::Concat(vector, otherArray->vector));
+    }
+    return With(PersistentVector<T>::Concat(vector, PersistentVector<T>(other->begin(), other->end())));
 }
 
 template <typename T>
 ISequence<T>* ImmutableArraySequence<T>::AddToEnd(T item) {
-    ArraySequence<T>* copy = new ArraySequence<T>(*this);
-    copy->AddToEnd(item);
-    return new ImmutableArraySequence<T>(*copy);
+    PersistentVector<T> edited(vector);
+    edited.PushBack(std::move(item));
+    return With(std::move(edited));
 }
 
 template <typename T>
 ISequence<T>* ImmutableArraySequence<T>::AddToFront(T item) {
-    ArraySequence<T>* copy = new ArraySequence<T>(*this);
-    copy->AddToFront(item);
-    return new ImmutableArraySequence<T>(*copy);
+    PersistentVector<T> edited(vector);
+    edited.Insert(0, std::move(item));
+    return With(std::move(edited));
 }
 
 template <typename T>
 ISequence<T>* ImmutableArraySequence<T>::Insert(T item, int index) {
-    ArraySequence<T>* copy = new ArraySequence<T>(*this);
-    copy->Insert(item, index);
-    return new ImmutableArraySequence<T>(*copy);
+    PersistentVector<T> edited(vector);
+    edited.Insert(index, std::move(item));
+    return With(std::move(edited));
 }
 
 template <typename T>
 ISequence<T>* ImmutableArraySequence<T>::Delete(int index) {
-    ArraySequence<T>* copy = new ArraySequence<T>(*this);
-    copy->Delete(index);
-    return new ImmutableArraySequence<T>(*copy);
+    if (vector.GetSize() == 0) throw Errors::EmptyContainer();
+    PersistentVector<T> edited(vector);
+    edited.Remove(index);
+    return With(std::move(edited));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::EmplaceBackWith(const ElementConstructor<T>& construct) {
+    PersistentVector<T> edited(vector);
+    edited.InsertWith(construct, vector.GetSize());
+    return With(std::move(edited));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::EmplaceFrontWith(const ElementConstructor<T>& construct) {
+    PersistentVector<T> edited(vector);
+    edited.InsertWith(construct, 0);
+    return With(std::move(edited));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::EmplaceAtWith(const ElementConstructor<T>& construct, int index) {
+    PersistentVector<T> edited(vector);
+    edited.InsertWith(construct, index);
+    return With(std::move(edited));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::AddRange(const T* items, int count) {
+    if (count < 0) throw Errors::NegativeCount();
+    return With(PersistentVector<T>::Concat(vector, PersistentVector<T>(items, items + count)));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::AddRange(const ISequence<T>* other) {
+    return Combine(other);
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::InsertRange(const T* items, int count, int index) {
+    if (count < 0) throw Errors::NegativeCount();
+    PersistentVector<T> edited(vector);
+    edited.InsertRange(index, items, items + count);
+    return With(std::move(edited));
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::SortWith(const ElementComparer<T>& less) {
+    std::vector<T> items(vector.begin(), vector.end());
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) {
+            Sorting::SortRange(items.data(), static_cast<int>(items.size()), std::less<>(), false, 1);
+            return new ImmutableArraySequence<T>(items.begin(), items.end());
+        }
+    }
+    std::sort(items.begin(), items.end(), less);
+    return new ImmutableArraySequence<T>(items.begin(), items.end());
+}
+
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::StableSortWith(const ElementComparer<T>& less) {
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) return SortWith(less);  // the radix path is stable
+    }
+    std::vector<T> items(vector.begin(), vector.end());
+    std::stable_sort(items.begin(), items.end(), less);
+    return new ImmutableArraySequence<T>(items.begin(), items.end());
 }
 
 template <typename T>
 ISequence<T>* ImmutableArraySequence<T>::GetReference() {
-    return new ImmutableArraySequence<T>(*this);
+    return Copy();
 }
 
 template <typename T>
@@ -254,4 +638,26 @@ ISequence<T>* ImmutableArraySequence<T>::Copy() const {
     return new ImmutableArraySequence<T>(*this);
 }
 
+template <typename T>
+ISequence<T>* ImmutableArraySequence<T>::Set(int index, T item) const {
+    PersistentVector<T> edited(vector);
+    edited.Set(index, std::move(item));
+    return With(std::move(edited));
+}
+
+template <typename T>
+typename PersistentVector<T>::ConstIterator ImmutableArraySequence<T>::begin() const {
+    return vector.begin();
+}
+
+template <typename T>
+typename PersistentVector<T>::ConstIterator ImmutableArraySequence<T>::end() const {
+    return vector.end();
+}
+
+template <typename T>
+std::unique_ptr<typename ISequence<T>::Cursor> ImmutableArraySequence<T>::CreateCursor() const {
+    return std::make_unique<VectorCursor>(vector.begin());
+}
+
 #endif
@@ -0,0 +1,555 @@
+#ifndef DEQUE_SEQUENCE_HPP
+#define DEQUE_SEQUENCE_HPP
+
+#include "errors.hpp"
+#include "sequence.hpp"
+#include "sort.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Double-ended array. The elements occupy [head, head + count) of a raw
+// buffer that keeps spare room on both sides, so AddToEnd and AddToFront are
+// amortized O(1) while At stays a single indexed load. Middle insertions and
+// deletions shift whichever side of the position is shorter.
+template <typename T>
+class DequeSequence : public ISequence<T> {
+protected:
+    T* buffer;
+    int capacity;
+    int head;
+    int count;
+
+    static constexpr int MinimumCapacity = 8;
+
+    static T* Allocate(int size);
+    static void Deallocate(T* block, int size);
+    static void CopyInto(const T* items, int size, T* destination);
+    static void Relocate(T* first, T* last, T* destination);
+    static void Shift(T* first, T* last, T* destination);
+    void Reposition(int newCapacity, int newHead);
+    void Rebuild(int index, const T* items, int size);
+    void EnsureFront(int needed);
+    void EnsureBack(int needed);
+    void Grow(int needed);
+    T* OpenHole(int index);
+    void CloseHole(int index);
+    std::unique_ptr<typename ISequence<T>::Cursor> CreateCursor() const override;
+
+public:
+    DequeSequence();
+    DequeSequence(T* items, int size);
+    template <typename InputIt, EnableIfIterator<InputIt> = 0>
+    DequeSequence(InputIt first, InputIt last);
+    DequeSequence(const DequeSequence<T>& other);
+    DequeSequence(DequeSequence<T>&& other) noexcept;
+    ~DequeSequence() override;
+
+    DequeSequence<T>& operator=(const DequeSequence<T>& other);
+    DequeSequence<T>& operator=(DequeSequence<T>&& other) noexcept;
+
+    void Reserve(int front, int back);
+
+    const T& Front() const final;
+    const T& Back() const final;
+    const T& At(int index) const final;
+    T& Front();
+    T& Back();
+    T& At(int index);
+    ISequence<T>* AddToEnd(T item) override;
+    ISequence<T>* AddToFront(T item) override;
+    ISequence<T>* Insert(T item, int index) override;
+    ISequence<T>* Delete(int index) override;
+    ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) override;
+    ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int index) override;
+    ISequence<T>* AddRange(const T* items, int size) override;
+    ISequence<T>* AddRange(const ISequence<T>* other) override;
+    ISequence<T>* InsertRange(const T* items, int size, int index) override;
+    ISequence<T>* Slice(int start, int end) const override;
+    ISequence<T>* Combine(const ISequence<T>* other) const override;
+    int Size() const final;
+    bool ForEachChunk(const ChunkVisitor<T>& visit) const override;
+    bool Equals(const ISequence<T>* other) const override;
+    const Hashing::Fingerprint* CachedFingerprint() const override;
+    ISequence<T>* SortWith(const ElementComparer<T>& less) override;
+    ISequence<T>* StableSortWith(const ElementComparer<T>& less) override;
+    ISequence<T>* GetReference() override;
+    ISequence<T>* Copy() const override;
+
+    template <typename Less = std::less<>, typename Policy = Execution::SequencedPolicy>
+    ISequence<T>* Sort(const Less& less = Less(), const Policy& policy = Policy());
+    template <typename Less = std::less<>, typename Policy = Execution::SequencedPolicy>
+    ISequence<T>* StableSort(const Less& less = Less(), const Policy& policy = Policy());
+
+    int Capacity() const;
+
+    const T* begin() const;
+    const T* end() const;
+};
+
+template <typename T>
+T* DequeSequence<T>::Allocate(int size) {
+    if (size == 0) return nullptr;
+    return std::allocator<T>().allocate(size);
+}
+
+template <typename T>
+void DequeSequence<T>::Deallocate(T* block, int size) {
+    if (block) std::allocator<T>().deallocate(block, size);
+}
+
+template <typename T>
+void DequeSequence<T>::CopyInto(const T* items, int size, T* destination) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (size > 0) std::memcpy(static_cast<void*>(destination), items, sizeof(T) * size);
+    } else {
+        std::uninitialized_copy_n(items, size, destination);
+    }
+}
+
+template <typename T>
+void DequeSequence<T>::Relocate(T* first, T* last, T* destination) {
+    if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+        std::uninitialized_move(first, last, destination);
+    } else {
+        std::uninitialized_copy(first, last, destination);
+    }
+}
+
+// Moves the live range [first, last) by one slot inside the buffer. The slot
+// it moves into must be raw; afterwards the slot it vacated is raw.
+template <typename T>
+void DequeSequence<T>::Shift(T* first, T* last, T* destination) {
+    if (first == last) return;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(destination), first, sizeof(T) * (last - first));
+    } else if (destination < first) {
+        ::new (static_cast<void*>(destination)) T(std::move(*first));
+        std::move(first + 1, last, first);
+        std::destroy_at(last - 1);
+    } else {
+        ::new (static_cast<void*>(last)) T(std::move(*(last - 1)));
+        std::move_backward(first, last - 1, last);
+        std::destroy_at(first);
+    }
+}
+
+template <typename T>
+void DequeSequence<T>::Reposition(int newCapacity, int newHead) {
+    T* newBuffer = Allocate(newCapacity);
+    try {
+        Relocate(buffer + head, buffer + head + count, newBuffer + newHead);
+    } catch (...) {
+        Deallocate(newBuffer, newCapacity);
+        throw;
+    }
+    std::destroy(buffer + head, buffer + head + count);
+    Deallocate(buffer, capacity);
+    buffer = newBuffer;
+    capacity = newCapacity;
+    head = newHead;
+}
+
+// Builds a fresh, centered buffer holding the current elements with `size`
+// copies of `items` spliced in at `index`. The new elements are copied before
+// the old buffer is released, so `items` may point into this sequence.
+template <typename T>
+void DequeSequence<T>::Rebuild(int index, const T* items, int size) {
+    int newCount = count + size;
+    int newCapacity = std::max(MinimumCapacity, newCount * 2);
+    int newHead = (newCapacity - newCount) / 2;
+    T* newBuffer = Allocate(newCapacity);
+    T* inserted = newBuffer + newHead + index;
+    try {
+        CopyInto(items, size, inserted);
+    } catch (...) {
+        Deallocate(newBuffer, newCapacity);
+        throw;
+    }
+    try {
+        Relocate(buffer + head, buffer + head + index, newBuffer + newHead);
+    } catch (...) {
+        std::destroy(inserted, inserted + size);
+        Deallocate(newBuffer, newCapacity);
+        throw;
+    }
+    try {
+        Relocate(buffer + head + index, buffer + head + count, inserted + size);
+    } catch (...) {
+        std::destroy(newBuffer + newHead, newBuffer + newHead + index);
+        std::destroy(inserted, inserted + size);
+        Deallocate(newBuffer, newCapacity);
+        throw;
+    }
+    std::destroy(buffer + head, buffer + head + count);
+    Deallocate(buffer, capacity);
+    buffer = newBuffer;
+    capacity = newCapacity;
+    head = newHead;
+    count = newCount;
+}
+
+// Recenters the elements, doubling the buffer unless it is at most half full.
+// Either way both ends come out with at least `needed` free slots.
+template <typename T>
+void DequeSequence<T>::Grow(int needed) {
+    int required = count + needed;
+    int newCapacity = capacity;
+    if (required * 2 > capacity) {
+        newCapacity = std::max({MinimumCapacity, capacity * 2, required * 2});
+    }
+    Reposition(newCapacity, (newCapacity - count) / 2);
+}
+
+template <typename T>
+void DequeSequence<T>::EnsureFront(int needed) {
+    if (head < needed) Grow(needed);
+}
+
+template <typename T>
+void DequeSequence<T>::EnsureBack(int needed) {
+    if (capacity - head - count < needed) Grow(needed);
+}
+
+// Makes position `index` a raw slot by shifting the shorter side outwards.
+template <typename T>
+T* DequeSequence<T>::OpenHole(int index) {
+    if (index < count - index) {
+        EnsureFront(1);
+        Shift(buffer + head, buffer + head + index, buffer + head - 1);
+        head--;
+    } else {
+        EnsureBack(1);
+        Shift(buffer + head + index, buffer + head + count, buffer + head + index + 1);
+    }
+    count++;
+    return buffer + head + index;
+}
+
+// Fills the raw slot at position `index` by shifting the shorter side inwards.
+template <typename T>
+void DequeSequence<T>::CloseHole(int index) {
+    if (index < count - 1 - index) {
+        Shift(buffer + head, buffer + head + index, buffer + head + 1);
+        head++;
+    } else {
+        Shift(buffer + head + index + 1, buffer + head + count, buffer + head + index);
+    }
+    count--;
+}
+
+template <typename T>
+DequeSequence<T>::DequeSequence() : buffer(nullptr), capacity(0), head(0), count(0) {}
+
+template <typename T>
+DequeSequence<T>::DequeSequence(T* items, int size) : DequeSequence() {
+    if (size < 0) throw Errors::InvalidSize();
+    Rebuild(0, items, size);
+}
+
+template <typename T>
+template <typename InputIt, EnableIfIterator<InputIt>>
+DequeSequence<T>::DequeSequence(InputIt first, InputIt last) : DequeSequence() {
+    for (; first != last; ++first) AddToEnd(*first);
+}
+
+template <typename T>
+DequeSequence<T>::DequeSequence(const DequeSequence<T>& other) : DequeSequence() {
+    T* block = Allocate(other.count);
+    try {
+        CopyInto(other.buffer + other.head, other.count, block);
+    } catch (...) {
+        Deallocate(block, other.count);
+        throw;
+    }
+    buffer = block;
+    capacity = count = other.count;
+}
+
+template <typename T>
+DequeSequence<T>::DequeSequence(DequeSequence<T>&& other) noexcept
+    : buffer(std::exchange(other.buffer, nullptr)),
+      capacity(std::exchange(other.capacity, 0)),
+      head(std::exchange(other.head, 0)),
+      count(std::exchange(other.count, 0)) {}
+
+template <typename T>
+DequeSequence<T>::~DequeSequence() {
+    std::destroy(buffer + head, buffer + head + count);
+    Deallocate(buffer, capacity);
+}
+
+template <typename T>
+DequeSequence<T>& DequeSequence<T>::operator=(const DequeSequence<T>& other) {
+    if (this != &other) {
+        DequeSequence<T> copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+DequeSequence<T>& DequeSequence<T>::operator=(DequeSequence<T>&& other) noexcept {
+    if (this != &other) {
+        std::destroy(buffer + head, buffer + head + count);
+        Deallocate(buffer, capacity);
+        buffer = std::exchange(other.buffer, nullptr);
+        capacity = std::exchange(other.capacity, 0);
+        head = std::exchange(other.head, 0);
+        count = std::exchange(other.count, 0);
+    }
+    return *this;
+}
+
+template <typename T>
+void DequeSequence<T>::Reserve(int front, int back) {
+    if (front < 0 || back < 0) throw Errors::InvalidSize();
+    if (head >= front && capacity - head - count >= back) return;
+    int newCapacity = std::max(capacity, front + count + back);
+    Reposition(newCapacity, front + (newCapacity - front - count - back) / 2);
+}
+
+template <typename T>
+const T& DequeSequence<T>::Front() const {
+    if (count == 0) throw Errors::EmptyContainer();
+    return buffer[head];
+}
+
+template <typename T>
+const T& DequeSequence<T>::Back() const {
+    if (count == 0) throw Errors::EmptyContainer();
+    return buffer[head + count - 1];
+}
+
+template <typename T>
+const T& DequeSequence<T>::At(int index) const {
+    if (index < 0 || index >= count) throw Errors::IndexOutOfRange();
+    return buffer[head + index];
+}
+
+template <typename T>
+T& DequeSequence<T>::Front() {
+    return const_cast<T&>(std::as_const(*this).Front());
+}
+
+template <typename T>
+T& DequeSequence<T>::Back() {
+    return const_cast<T&>(std::as_const(*this).Back());
+}
+
+template <typename T>
+T& DequeSequence<T>::At(int index) {
+    return const_cast<T&>(std::as_const(*this).At(index));
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::AddToEnd(T item) {
+    EnsureBack(1);
+    ::new (static_cast<void*>(buffer + head + count)) T(std::move(item));
+    count++;
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::AddToFront(T item) {
+    EnsureFront(1);
+    ::new (static_cast<void*>(buffer + head - 1)) T(std::move(item));
+    head--;
+    count++;
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::Insert(T item, int index) {
+    if (index < 0 || index > count) throw Errors::IndexOutOfRange();
+    T* slot = OpenHole(index);
+    try {
+        ::new (static_cast<void*>(slot)) T(std::move(item));
+    } catch (...) {
+        CloseHole(index);
+        throw;
+    }
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::Delete(int index) {
+    if (index < 0 || index >= count) throw Errors::IndexOutOfRange();
+    std::destroy_at(buffer + head + index);
+    CloseHole(index);
+    return this;
+}
+
+// With room at the requested end the element is built straight into its
+// slot. When the buffer has to move first it is built beforehand, so the
+// arguments may refer to elements of this sequence. In the middle the hole
+// is opened first, which moves neighbouring elements, so there they may not.
+template <typename T>
+ISequence<T>* DequeSequence<T>::EmplaceBackWith(const ElementConstructor<T>& construct) {
+    if (capacity - head - count < 1) return AddToEnd(construct());
+    ::new (static_cast<void*>(buffer + head + count)) T(construct());
+    count++;
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::EmplaceFrontWith(const ElementConstructor<T>& construct) {
+    if (head < 1) return AddToFront(construct());
+    ::new (static_cast<void*>(buffer + head - 1)) T(construct());
+    head--;
+    count++;
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::EmplaceAtWith(const ElementConstructor<T>& construct, int index) {
+    if (index < 0 || index > count) throw Errors::IndexOutOfRange();
+    if (index == count) return EmplaceBackWith(construct);
+    if (index == 0) return EmplaceFrontWith(construct);
+    T* slot = OpenHole(index);
+    try {
+        ::new (static_cast<void*>(slot)) T(construct());
+    } catch (...) {
+        CloseHole(index);
+        throw;
+    }
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::AddRange(const T* items, int size) {
+    return InsertRange(items, size, count);
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::AddRange(const ISequence<T>* other) {
+    if (const auto* otherDeque = dynamic_cast<const DequeSequence<T>*>(other)) {
+        return InsertRange(otherDeque->buffer + otherDeque->head, otherDeque->count, count);
+    }
+    EnsureBack(other->Size());
+    for (const T& item : *other) {
+        ::new (static_cast<void*>(buffer + head + count)) T(item);
+        count++;
+    }
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::InsertRange(const T* items, int size, int index) {
+    if (size < 0) throw Errors::NegativeCount();
+    if (index < 0 || index > count) throw Errors::IndexOutOfRange();
+    if (size == 0) return this;
+    if (index == count && capacity - head - count >= size) {
+        CopyInto(items, size, buffer + head + count);
+        count += size;
+    } else if (index == 0 && head >= size) {
+        CopyInto(items, size, buffer + head - size);
+        head -= size;
+        count += size;
+    } else {
+        Rebuild(index, items, size);
+    }
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::Slice(int start, int end) const {
+    if (start < 0 || end >= count || start > end) throw Errors::IndexOutOfRange();
+    return new DequeSequence<T>(buffer + head + start, end - start + 1);
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::Combine(const ISequence<T>* other) const {
+    DequeSequence<T>* result = new DequeSequence<T>();
+    result->Reserve(0, count + other->Size());
+    result->AddRange(buffer + head, count);
+    result->AddRange(other);
+    return result;
+}
+
+template <typename T>
+int DequeSequence<T>::Size() const {
+    return count;
+}
+
+template <typename T>
+bool DequeSequence<T>::ForEachChunk(const ChunkVisitor<T>& visit) const {
+    return count == 0 || visit(buffer + head, count);
+}
+
+template <typename T>
+bool DequeSequence<T>::Equals(const ISequence<T>* other) const {
+    return this->EqualElements(other);
+}
+
+template <typename T>
+const Hashing::Fingerprint* DequeSequence<T>::CachedFingerprint() const {
+    return nullptr;
+}
+
+template <typename T>
+template <typename Less, typename Policy>
+ISequence<T>* DequeSequence<T>::Sort(const Less& less, const Policy& policy) {
+    if (count > 1) Sorting::SortRange(buffer + head, count, less, false, Execution::PartCount(policy, count));
+    return this;
+}
+
+template <typename T>
+template <typename Less, typename Policy>
+ISequence<T>* DequeSequence<T>::StableSort(const Less& less, const Policy& policy) {
+    if (count > 1) Sorting::SortRange(buffer + head, count, less, true, Execution::PartCount(policy, count));
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::SortWith(const ElementComparer<T>& less) {
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) return Sort();
+    }
+    return Sort(less);
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::StableSortWith(const ElementComparer<T>& less) {
+    if constexpr (Sorting::IsRadixKey<T>::value) {
+        if (less.IsNaturalOrder()) return StableSort();
+    }
+    return StableSort(less);
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::GetReference() {
+    return this;
+}
+
+template <typename T>
+ISequence<T>* DequeSequence<T>::Copy() const {
+    return new DequeSequence<T>(*this);
+}
+
+template <typename T>
+int DequeSequence<T>::Capacity() const {
+    return capacity;
+}
+
+template <typename T>
+const T* DequeSequence<T>::begin() const {
+    return buffer + head;
+}
+
+template <typename T>
+const T* DequeSequence<T>::end() const {
+    return buffer + head + count;
+}
+
+template <typename T>
+std::unique_ptr<typename ISequence<T>::Cursor> DequeSequence<T>::CreateCursor() const {
+    return std::make_unique<typename ISequence<T>::PointerCursor>(buffer + head);
+}
+
+#endif
@@ -3,61 +3,205 @@
 
 #include "errors.hpp"
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+// Elements live in raw storage: only the first `size` slots hold constructed
+// objects, the remaining `capacity - size` slots are uninitialized bytes.
 template <typename T>
 class DynamicArray {
 protected:
     T* data;
     int size;
+    int capacity;
+
+    static T* Allocate(int count);
+    static void Deallocate(T* block, int count);
+    template <typename It>
+    static constexpr bool IsPointerToElement =
+        std::is_pointer<It>::value && std::is_same<std::remove_cv_t<std::remove_pointer_t<It>>, T>::value;
+
+    template <typename ForwardIt>
+    static void CopyInto(ForwardIt first, int count, T* destination);
+    static void Relocate(T* first, T* last, T* destination);
+    void TransferTo(T* newData);
+    bool Contains(const T* item) const;
+    void Adopt(T* newData, int newCapacity);
+    void Reallocate(int newCapacity);
 
 public:
     DynamicArray();
     DynamicArray(int size);
     DynamicArray(T* items, int size);
     DynamicArray(const DynamicArray<T>& other);
+    DynamicArray(DynamicArray<T>&& other) noexcept;
     ~DynamicArray();
 
+    DynamicArray<T>& operator=(const DynamicArray<T>& other);
+    DynamicArray<T>& operator=(DynamicArray<T>&& other) noexcept;
+
     T& Get(int index);
     const T& Get(int index) const;
     void Set(int index, T value);
+    void PushBack(T value);
+    void Insert(int index, T value);
+    template <typename Construct>
+    T& AppendWith(const Construct& construct);
+    template <typename Construct>
+    T& InsertAtWith(const Construct& construct, int index);
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last);
+    template <typename InputIt>
+    void InsertRange(int index, InputIt first, InputIt last);
+    T* GetData();
+    const T* GetData() const;
     int GetSize() const;
+    int GetCapacity() const;
+    void Reserve(int newCapacity);
     void Resize(int newSize);
     void Remove(int index);
     DynamicArray<T>* GetSubArray(int start, int end) const;
+
+    bool operator==(const DynamicArray<T>& other) const;
+    bool operator!=(const DynamicArray<T>& other) const;
 };
 
 template <typename T>
-DynamicArray<T>::DynamicArray() : data(nullptr), size(0) {}
+T* DynamicArray<T>::Allocate(int count) {
+    if (count == 0) return nullptr;
+    return std::allocator<T>().allocate(count);
+}
 
 template <typename T>
-DynamicArray<T>::DynamicArray(int size) : size(size) {
-    if (size < 0) throw Errors::InvalidSize();
-    data = new T[size];
-    for (int i = 0; i < size; i++) {
-        data[i] = T();
+void DynamicArray<T>::Deallocate(T* block, int count) {
+    if (block) std::allocator<T>().deallocate(block, count);
+}
+
+// Contiguous ranges of trivially copyable elements are copied with a single
+// memcpy; anything else is copy- (or, through move iterators, move-)
+// constructed element by element.
+template <typename T>
+template <typename ForwardIt>
+void DynamicArray<T>::CopyInto(ForwardIt first, int count, T* destination) {
+    if constexpr (IsPointerToElement<ForwardIt> && std::is_trivially_copyable<T>::value) {
+        if (count > 0) std::memcpy(destination, first, sizeof(T) * count);
+    } else {
+        std::uninitialized_copy_n(first, count, destination);
+    }
+}
+
+template <typename T>
+void DynamicArray<T>::Relocate(T* first, T* last, T* destination) {
+    if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+        std::uninitialized_move(first, last, destination);
+    } else {
+        std::uninitialized_copy(first, last, destination);
+    }
+}
+
+template <typename T>
+void DynamicArray<T>::TransferTo(T* newData) {
+    Relocate(data, data + size, newData);
+}
+
+template <typename T>
+bool DynamicArray<T>::Contains(const T* item) const {
+    std::less<const T*> before;
+    return !before(item, data) && before(item, data + size);
+}
+
+template <typename T>
+void DynamicArray<T>::Adopt(T* newData, int newCapacity) {
+    std::destroy(data, data + size);
+    Deallocate(data, capacity);
+    data = newData;
+    capacity = newCapacity;
+}
+
+template <typename T>
+void DynamicArray<T>::Reallocate(int newCapacity) {
+    T* newData = Allocate(newCapacity);
+    try {
+        TransferTo(newData);
+    } catch (...) {
+        Deallocate(newData, newCapacity);
+        throw;
     }
+    Adopt(newData, newCapacity);
 }
 
 template <typename T>
-DynamicArray<T>::DynamicArray(T* items, int size) : size(size) {
+DynamicArray<T>::DynamicArray() : data(nullptr), size(0), capacity(0) {}
+
+template <typename T>
+DynamicArray<T>::DynamicArray(int size) : data(nullptr), size(0), capacity(0) {
     if (size < 0) throw Errors::InvalidSize();
-    data = new T[size];
-    for (int i = 0; i < size; i++) {
-        data[i] = items[i];
+    data = Allocate(size);
+    capacity = size;
+    try {
+        std::uninitialized_value_construct(data, data + size);
+    } catch (...) {
+        Deallocate(data, capacity);
+        throw;
     }
+    this->size = size;
 }
 
 template <typename T>
-DynamicArray<T>::DynamicArray(const DynamicArray<T>& other) : size(other.size) {
-    data = new T[size];
-    for (int i = 0; i < size; i++) {
-        data[i] = other.data[i];
+DynamicArray<T>::DynamicArray(T* items, int size) : data(nullptr), size(0), capacity(0) {
+    if (size < 0) throw Errors::InvalidSize();
+    data = Allocate(size);
+    capacity = size;
+    try {
+        std::uninitialized_copy(items, items + size, data);
+    } catch (...) {
+        Deallocate(data, capacity);
+        throw;
     }
+    this->size = size;
 }
 
+template <typename T>
+DynamicArray<T>::DynamicArray(const DynamicArray<T>& other) : DynamicArray(other.data, other.size) {}
+
+template <typename T>
+DynamicArray<T>::DynamicArray(DynamicArray<T>&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      size(std::exchange(other.size, 0)),
+      capacity(std::exchange(other.capacity, 0)) {}
+
 template <typename T>
 DynamicArray<T>::~DynamicArray() {
-    delete[] data;
+    std::destroy(data, data + size);
+    Deallocate(data, capacity);
+}
+
+template <typename T>
+DynamicArray<T>& DynamicArray<T>::operator=(const DynamicArray<T>& other) {
+    if (this != &other) {
+        DynamicArray<T> copy(other);
+        std::swap(data, copy.data);
+        std::swap(size, copy.size);
+        std::swap(capacity, copy.capacity);
+    }
+    return *this;
+}
+
+template <typename T>
+DynamicArray<T>& DynamicArray<T>::operator=(DynamicArray<T>&& other) noexcept {
+    if (this != &other) {
+        std::destroy(data, data + size);
+        Deallocate(data, capacity);
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        capacity = std::exchange(other.capacity, 0);
+    }
+    return *this;
 }
 
 template <typename T>
@@ -78,44 +222,210 @@ void DynamicArray<T>::Set(int index, T value) {
     data[index] = std::move(value);
 }
 
+template <typename T>
+void DynamicArray<T>::PushBack(T value) {
+    if (size == capacity) Reallocate(std::max(1, capacity * 2));
+    ::new (static_cast<void*>(data + size)) T(std::move(value));
+    size++;
+}
+
+// `construct()` returns the new element by value, so it is materialized
+// directly in its slot. When the buffer is full the element is built in the
+// new block before the old ones move, which keeps arguments that refer into
+// this array valid.
+template <typename T>
+template <typename Construct>
+T& DynamicArray<T>::AppendWith(const Construct& construct) {
+    if (size < capacity) {
+        ::new (static_cast<void*>(data + size)) T(construct());
+    } else {
+        int newCapacity = std::max(1, capacity * 2);
+        T* newData = Allocate(newCapacity);
+        try {
+            ::new (static_cast<void*>(newData + size)) T(construct());
+        } catch (...) {
+            Deallocate(newData, newCapacity);
+            throw;
+        }
+        try {
+            TransferTo(newData);
+        } catch (...) {
+            std::destroy_at(newData + size);
+            Deallocate(newData, newCapacity);
+            throw;
+        }
+        Adopt(newData, newCapacity);
+    }
+    return data[size++];
+}
+
+// Shifting is a single memmove for trivially copyable T and a move-based
+// loop otherwise; either way the new element is built before anything moves.
+template <typename T>
+void DynamicArray<T>::Insert(int index, T value) {
+    if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+    if (size == capacity) Reallocate(std::max(1, capacity * 2));
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(data + index + 1), data + index, sizeof(T) * (size - index));
+        ::new (static_cast<void*>(data + index)) T(std::move(value));
+        size++;
+    } else if (index == size) {
+        ::new (static_cast<void*>(data + size)) T(std::move(value));
+        size++;
+    } else {
+        ::new (static_cast<void*>(data + size)) T(std::move(data[size - 1]));
+        size++;
+        std::move_backward(data + index, data + size - 2, data + size - 1);
+        data[index] = std::move(value);
+    }
+}
+
+template <typename T>
+template <typename Construct>
+T& DynamicArray<T>::InsertAtWith(const Construct& construct, int index) {
+    if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        Insert(index, construct());
+    } else {
+        AppendWith(construct);
+        std::rotate(data + index, data + size - 1, data + size);
+    }
+    return data[index];
+}
+
+template <typename T>
+template <typename InputIt>
+void DynamicArray<T>::AppendRange(InputIt first, InputIt last) {
+    InsertRange(size, first, last);
+}
+
+// Sizes the destination once. Appending into spare capacity constructs the
+// new elements in place; inserting trivially copyable elements shifts the
+// tail with one memmove; every other case builds a single new buffer.
+template <typename T>
+template <typename InputIt>
+void DynamicArray<T>::InsertRange(int index, InputIt first, InputIt last) {
+    if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (!std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        DynamicArray<T> buffered;
+        for (; first != last; ++first) buffered.PushBack(*first);
+        InsertRange(index, std::make_move_iterator(buffered.data),
+                    std::make_move_iterator(buffered.data + buffered.size));
+    } else {
+        int count = static_cast<int>(std::distance(first, last));
+        if (count == 0) return;
+
+        if (size + count <= capacity) {
+            if (index == size) {
+                CopyInto(first, count, data + size);
+                size += count;
+                return;
+            }
+            if constexpr (IsPointerToElement<InputIt> && std::is_trivially_copyable<T>::value) {
+                if (!Contains(first)) {
+                    std::memmove(data + index + count, data + index, sizeof(T) * (size - index));
+                    CopyInto(first, count, data + index);
+                    size += count;
+                    return;
+                }
+            }
+        }
+
+        int newCapacity = size + count <= capacity ? capacity : std::max(size + count, capacity * 2);
+        T* newData = Allocate(newCapacity);
+        T* inserted = newData + index;
+        try {
+            CopyInto(first, count, inserted);
+        } catch (...) {
+            Deallocate(newData, newCapacity);
+            throw;
+        }
+        try {
+            Relocate(data, data + index, newData);
+        } catch (...) {
+            std::destroy(inserted, inserted + count);
+            Deallocate(newData, newCapacity);
+            throw;
+        }
+        try {
+            Relocate(data + index, data + size, inserted + count);
+        } catch (...) {
+            std::destroy(newData, newData + index);
+            std::destroy(inserted, inserted + count);
+            Deallocate(newData, newCapacity);
+            throw;
+        }
+        Adopt(newData, newCapacity);
+        size += count;
+    }
+}
+
+template <typename T>
+T* DynamicArray<T>::GetData() {
+    return data;
+}
+
+template <typename T>
+const T* DynamicArray<T>::GetData() const {
+    return data;
+}
+
 template <typename T>
 int DynamicArray<T>::GetSize() const {
     return size;
 }
 
+template <typename T>
+int DynamicArray<T>::GetCapacity() const {
+    return capacity;
+}
+
+template <typename T>
+void DynamicArray<T>::Reserve(int newCapacity) {
+    if (newCapacity < 0) throw Errors::InvalidSize();
+    if (newCapacity <= capacity) return;
+    Reallocate(newCapacity);
+}
+
 template <typename T>
 void DynamicArray<T>::Resize(int newSize) {
     if (newSize < 0) throw Errors::InvalidSize();
-    T* newData = new T[newSize];
-    int copySize = std::min(newSize, size);
-    for (int i = 0; i < copySize; i++) {
-        newData[i] = std::move(data[i]);
-    }
-    for (int i = copySize; i < newSize; i++) {
-        newData[i] = T();
+    if (newSize > capacity) Reallocate(newSize);
+    if (newSize > size) {
+        std::uninitialized_value_construct(data + size, data + newSize);
+    } else {
+        std::destroy(data + newSize, data + size);
     }
-    delete[] data;
-    data = newData;
     size = newSize;
 }
 
 template <typename T>
 void DynamicArray<T>::Remove(int index) {
     if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
-    for (int i = index; i < size - 1; i++) {
-        data[i] = data[i + 1];
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(data + index), data + index + 1, sizeof(T) * (size - index - 1));
+    } else {
+        std::move(data + index + 1, data + size, data + index);
+        std::destroy_at(data + size - 1);
     }
     size--;
 }
 
 template <typename T>
 DynamicArray<T>* DynamicArray<T>::GetSubArray(int start, int end) const {
-    if (start < 0 || end > size || start > end) throw Errors::IndexOutOfRange();
-    DynamicArray<T>* result = new DynamicArray<T>(end - start);
-    for (int i = start; i < end; i++) {
-        result->Set(i - start, data[i]);
-    }
-    return result;
+    if (start < 0 || end >= size || start > end) throw Errors::IndexOutOfRange();
+    return new DynamicArray<T>(data + start, end - start + 1);
+}
+
+template <typename T>
+bool DynamicArray<T>::operator==(const DynamicArray<T>& other) const {
+    return size == other.size && std::equal(data, data + size, other.data);
+}
+
+template <typename T>
+bool DynamicArray<T>::operator!=(const DynamicArray<T>& other) const {
+    return !(*this == other);
 }
 
 #endif
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace Hashing {
+
+// Arithmetic and enum elements hash their value; anything else needs a
+// std::hash specialization.
+template <typename T>
+using IsHashable = std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                                                    std::is_default_constructible<std::hash<T>>::value>;
+
+constexpr std::uint64_t Base = 0x9E3779B97F4A7C15ULL;
+constexpr std::uint64_t Base4 = Base * Base * Base * Base;
+
+// splitmix64's finalizer: every input bit reaches every output bit.
+inline std::uint64_t Avalanche(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Cheap per-element scramble; the sequence hash is avalanched once at the end.
+inline std::uint64_t Scramble(std::uint64_t value) {
+    return (value ^ (value >> 29)) * 0xBF58476D1CE4E5B9ULL;
+}
+
+template <typename T>
+std::uint64_t ElementHash(const T& item) {
+    if constexpr (std::is_floating_point<T>::value) {
+        // 0.0 == -0.0, so both must hash alike.
+        double value = item == 0 ? 0.0 : static_cast<double>(item);
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        return Scramble(bits);
+    } else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value) {
+        return Scramble(static_cast<std::uint64_t>(item));
+    } else {
+        return Scramble(static_cast<std::uint64_t>(std::hash<T>()(item)));
+    }
+}
+
+// Order-sensitive polynomial hash, state = state * Base + hash(item), fed
+// one contiguous run at a time. Long runs are split across four lanes of
+// independent multiplies that are folded back exactly, so the result only
+// depends on the elements, never on how they were chunked.
+template <typename T>
+class Hasher {
+    std::uint64_t state = 0;
+    std::uint64_t count = 0;
+
+public:
+    void Add(const T* items, int size) {
+        int i = 0;
+        if (size >= 8) {
+            std::uint64_t lanes[4] = {0, 0, 0, 0};
+            std::uint64_t scale = 1;
+            for (; i + 4 <= size; i += 4) {
+                for (int lane = 0; lane < 4; lane++) lanes[lane] = lanes[lane] * Base4 + ElementHash(items[i + lane]);
+                scale *= Base4;
+            }
+            state = state * scale + ((lanes[0] * Base + lanes[1]) * Base + lanes[2]) * Base + lanes[3];
+        }
+        for (; i < size; i++) state = state * Base + ElementHash(items[i]);
+        count += static_cast<std::uint64_t>(size);
+    }
+
+    std::uint64_t Finish() const {
+        return Avalanche(state ^ Avalanche(count));
+    }
+};
+
+// Last hash computed for a sequence whose elements never change in place.
+// Copies and moves start empty and a move empties its source, so an edited
+// copy never reports its original's hash. The hash and the "known" flag are
+// one atomic word, 0 meaning unknown, so concurrent Hash() calls may each
+// compute and store it but never see a torn value; a hash that happens to
+// be 0 is simply not cached.
+class Fingerprint {
+    mutable std::atomic<std::uint64_t> value{0};
+
+public:
+    Fingerprint() = default;
+    Fingerprint(const Fingerprint&) {}
+    Fingerprint(Fingerprint&& other) noexcept { other.Reset(); }
+
+    Fingerprint& operator=(const Fingerprint&) {
+        Reset();
+        return *this;
+    }
+
+    Fingerprint& operator=(Fingerprint&& other) noexcept {
+        Reset();
+        other.Reset();
+        return *this;
+    }
+
+    // The cached hash, or 0 when none is known.
+    std::uint64_t Get() const { return value.load(std::memory_order_relaxed); }
+
+    void Set(std::uint64_t hash) const { value.store(hash, std::memory_order_relaxed); }
+
+    void Reset() const { value.store(0, std::memory_order_relaxed); }
+};
+
+}  // namespace Hashing
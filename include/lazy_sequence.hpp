@@ -0,0 +1,163 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include "array_sequence.hpp"
+#include "errors.hpp"
+#include "list_sequence.hpp"
+#include "sequence.hpp"
+
+// Deferred pipeline over a sequence. Each stage only wraps the previous one,
+// and nothing runs until a terminal call (ForEach, Reduce, Count or To*),
+// which pushes every element through all the stages in a single pass over
+// the source's ForEachChunk. No intermediate sequence is ever built.
+//
+// A Producer is called with a sink, feeds it elements until the sink
+// returns false, and returns false if the sink stopped it. The pipeline
+// refers to its source sequence, which must outlive it.
+template <typename T, typename Producer>
+class LazySequence {
+    Producer producer;
+
+    template <typename U, typename P>
+    static LazySequence<U, P> Make(P next) {
+        return LazySequence<U, P>(std::move(next));
+    }
+
+public:
+    explicit LazySequence(Producer producer) : producer(std::move(producer)) {}
+
+    template <typename F>
+    auto Map(F transform) const {
+        using U = std::decay_t<std::invoke_result_t<F&, const T&>>;
+        return Make<U>([producer = producer, transform](auto& sink) {
+            auto stage = [&](auto&& item) { return sink(transform(std::forward<decltype(item)>(item))); };
+            return producer(stage);
+        });
+    }
+
+    template <typename Predicate>
+    auto Where(Predicate predicate) const {
+        return Make<T>([producer = producer, predicate](auto& sink) {
+            auto stage = [&](auto&& item) {
+                return !predicate(item) || sink(std::forward<decltype(item)>(item));
+            };
+            return producer(stage);
+        });
+    }
+
+    // Stops pulling from the source once `count` elements have gone through.
+    auto Take(int count) const {
+        if (count < 0) throw Errors::InvalidSize();
+        return Make<T>([producer = producer, count](auto& sink) {
+            if (count == 0) return true;
+            int remaining = count;
+            bool stopped = false;
+            auto stage = [&](auto&& item) {
+                if (!sink(std::forward<decltype(item)>(item))) {
+                    stopped = true;
+                    return false;
+                }
+                return --remaining > 0;
+            };
+            producer(stage);
+            return !stopped;
+        });
+    }
+
+    auto Skip(int count) const {
+        if (count < 0) throw Errors::InvalidSize();
+        return Make<T>([producer = producer, count](auto& sink) {
+            int skipped = 0;
+            auto stage = [&](auto&& item) {
+                if (skipped < count) {
+                    skipped++;
+                    return true;
+                }
+                return sink(std::forward<decltype(item)>(item));
+            };
+            return producer(stage);
+        });
+    }
+
+    // Elements [start, end], like ISequence::Slice. The source size is not
+    // known up front, so a range past its end just yields fewer elements.
+    auto Slice(int start, int end) const {
+        if (start < 0 || start > end) throw Errors::InvalidRange();
+        return Skip(start).Take(end - start + 1);
+    }
+
+    // This pipeline's elements followed by `other`'s, like ISequence::Combine.
+    template <typename OtherProducer>
+    auto Combine(const LazySequence<T, OtherProducer>& other) const {
+        return Make<T>([first = producer, second = other.producer](auto& sink) {
+            return first(sink) && second(sink);
+        });
+    }
+
+    auto Combine(const ISequence<T>& other) const {
+        return Combine(Lazy(other));
+    }
+
+    template <typename F>
+    void ForEach(F action) const {
+        auto sink = [&](auto&& item) {
+            action(std::forward<decltype(item)>(item));
+            return true;
+        };
+        producer(sink);
+    }
+
+    template <typename Accumulator, typename F>
+    Accumulator Reduce(Accumulator initial, F combine) const {
+        ForEach([&](auto&& item) { initial = combine(std::move(initial), std::forward<decltype(item)>(item)); });
+        return initial;
+    }
+
+    int Count() const {
+        int count = 0;
+        ForEach([&](auto&&) { count++; });
+        return count;
+    }
+
+    ArraySequence<T> ToArraySequence() const {
+        ArraySequence<T> result;
+        ForEach([&](auto&& item) { result.AddToEnd(std::forward<decltype(item)>(item)); });
+        return result;
+    }
+
+    ListSequence<T> ToListSequence() const {
+        ListSequence<T> result;
+        ForEach([&](auto&& item) { result.AddToEnd(std::forward<decltype(item)>(item)); });
+        return result;
+    }
+
+    template <typename, typename>
+    friend class LazySequence;
+};
+
+// Feeds a pipeline from a sequence, one ForEachChunk call per pass.
+template <typename T>
+class SequenceSource {
+    const ISequence<T>* source;
+
+public:
+    explicit SequenceSource(const ISequence<T>* source) : source(source) {}
+
+    template <typename Sink>
+    bool operator()(Sink& sink) const {
+        auto chunk = [&](const T* items, int count) {
+            for (int i = 0; i < count; i++) {
+                if (!sink(items[i])) return false;
+            }
+            return true;
+        };
+        return source->ForEachChunk(ChunkVisitor<T>(chunk));
+    }
+};
+
+// Start of a deferred, fused pipeline over `source`.
+template <typename T>
+auto Lazy(const ISequence<T>& source) {
+    return LazySequence<T, SequenceSource<T>>(SequenceSource<T>(&source));
+}
@@ -1,76 +1,190 @@
 #pragma once
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include "errors.hpp"
+#include "node_pool.hpp"
 
 
-template <typename T>
+// Nodes come from NodeAllocator, a per-list NodePool by default; pass
+// HeapNodeAllocator to get one heap allocation per node instead.
+template <typename T, template <typename> class NodeAllocator = NodePool>
 class LinkedList {
 private:
     struct Node {
         T data;
         Node* next;
-        Node(T data) : data(data), next(nullptr) {}
-        Node(T data, Node* next) : data(data), next(next) {}
+        Node(T data) : data(std::move(data)), next(nullptr) {}
+        Node(T data, Node* next) : data(std::move(data)), next(next) {}
+        template <typename Construct>
+        Node(std::in_place_t, const Construct& construct, Node* next) : data(construct()), next(next) {}
     };
 
     Node* head;
     Node* tail;
     int size;
+    NodeAllocator<Node> nodes;
+
+    template <typename... Args>
+    Node* CreateNode(Args&&... args) {
+        Node* node = nodes.Allocate();
+        try {
+            ::new (static_cast<void*>(node)) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            nodes.Deallocate(node);
+            throw;
+        }
+        return node;
+    }
+
+    void DestroyNode(Node* node) noexcept {
+        std::destroy_at(node);
+        nodes.Deallocate(node);
+    }
+
+    // Merges two sorted chains; on ties the node from `left` comes first.
+    template <typename Less>
+    static Node* Merge(Node* left, Node* right, const Less& less) {
+        Node* merged = nullptr;
+        Node** link = &merged;
+        while (left && right) {
+            Node*& taken = less(right->data, left->data) ? right : left;
+            *link = taken;
+            link = &taken->next;
+            taken = taken->next;
+        }
+        *link = left ? left : right;
+        return merged;
+    }
 
 public:
+    class ConstIterator {
+        const Node* node;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit ConstIterator(const Node* node = nullptr) : node(node) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+
+        ConstIterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous(*this);
+            node = node->next;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return node == other.node; }
+        bool operator!=(const ConstIterator& other) const { return node != other.node; }
+    };
+
     LinkedList() : head(nullptr), tail(nullptr), size(0) {}
 
     LinkedList(T* items, int count) : head(nullptr), tail(nullptr), size(0) {
         if (count < 0) throw Errors::InvalidSize();
         if (count == 0) return;
         
-        head = new Node(items[0]);
+        head = CreateNode(items[0]);
         Node* current = head;
         size = count;
         
         for (int i = 1; i < count; i++) {
-            current->next = new Node(items[i]);
+            current->next = CreateNode(items[i]);
             current = current->next;
         }
         tail = current;
     }
 
-    LinkedList(const LinkedList<T>& other) : head(nullptr), tail(nullptr), size(0) {
+    LinkedList(const LinkedList& other) : head(nullptr), tail(nullptr), size(0) {
         if (!other.head) return;
         
-        head = new Node(other.head->data);
+        head = CreateNode(other.head->data);
         Node* current = head;
         Node* otherCurrent = other.head->next;
         size = other.size;
         
         while (otherCurrent) {
-            current->next = new Node(otherCurrent->data);
+            current->next = CreateNode(otherCurrent->data);
             current = current->next;
             otherCurrent = otherCurrent->next;
         }
         tail = current;
     }
 
+    LinkedList(LinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)),
+          tail(std::exchange(other.tail, nullptr)),
+          size(std::exchange(other.size, 0)),
+          nodes(std::move(other.nodes)) {}
+
     ~LinkedList() {
-        Node* current = head;
-        while (current) {
-            Node* next = current->next;
-            delete current;
-            current = next;
+        Clear();
+    }
+
+    LinkedList& operator=(const LinkedList& other) {
+        if (this != &other) {
+            LinkedList copy(other);
+            *this = std::move(copy);
         }
+        return *this;
     }
 
-    T GetFirst() const {
+    LinkedList& operator=(LinkedList&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            size = std::exchange(other.size, 0);
+            nodes = std::move(other.nodes);
+        }
+        return *this;
+    }
+
+    // A pool frees its slabs in bulk, so the walk is only needed to run
+    // element destructors (or to free nodes one by one from the heap).
+    void Clear() noexcept {
+        if (!NodeAllocator<Node>::BulkRelease || !std::is_trivially_destructible<T>::value) {
+            Node* current = head;
+            while (current) {
+                Node* next = current->next;
+                if (NodeAllocator<Node>::BulkRelease) {
+                    std::destroy_at(current);
+                } else {
+                    DestroyNode(current);
+                }
+                current = next;
+            }
+        }
+        nodes.ReleaseAll();
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    const T& GetFirst() const {
         if (!head) throw Errors::EmptyList();
         return head->data;
     }
 
-    T GetLast() const {
+    const T& GetLast() const {
         if (!tail) throw Errors::EmptyList();
         return tail->data;
     }
 
-    T Get(int index) const {
+    const T& Get(int index) const {
         if (!head) throw Errors::EmptyList();
         if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
         
@@ -81,11 +195,23 @@ public:
         return current->data;
     }
 
-    LinkedList<T>* GetSubList(int startIndex, int endIndex) const {
+    T& GetFirst() {
+        return const_cast<T&>(std::as_const(*this).GetFirst());
+    }
+
+    T& GetLast() {
+        return const_cast<T&>(std::as_const(*this).GetLast());
+    }
+
+    T& Get(int index) {
+        return const_cast<T&>(std::as_const(*this).Get(index));
+    }
+
+    LinkedList* GetSubList(int startIndex, int endIndex) const {
         if (startIndex < 0 || endIndex >= size || startIndex > endIndex)
             throw Errors::InvalidRange();
             
-        LinkedList<T>* sublist = new LinkedList<T>();
+        LinkedList* sublist = new LinkedList();
         Node* current = head;
         
         for (int i = 0; i < startIndex; i++) {
@@ -102,8 +228,21 @@ public:
 
     int GetLength() const { return size; }
 
+    ConstIterator begin() const { return ConstIterator(head); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
+
+    // Calls visit(items, count) once per node, in order, until it returns
+    // false; returns false if it stopped early.
+    template <typename Visit>
+    bool ForEachChunk(const Visit& visit) const {
+        for (const Node* node = head; node; node = node->next) {
+            if (!visit(&node->data, 1)) return false;
+        }
+        return true;
+    }
+
     void Append(T item) {
-        Node* newNode = new Node(item);
+        Node* newNode = CreateNode(std::move(item));
         if (!head) {
             head = tail = newNode;
         } else {
@@ -114,7 +253,7 @@ public:
     }
 
     void Prepend(T item) {
-        head = new Node(item, head);
+        head = CreateNode(std::move(item), head);
         if (!tail) tail = head;
         size++;
     }
@@ -122,11 +261,11 @@ public:
     void InsertAt(T item, int index) {
         if (index < 0 || index > size) throw Errors::IndexOutOfRange();
         if (index == 0) {
-            Prepend(item);
+            Prepend(std::move(item));
             return;
         }
         if (index == size) {
-            Append(item);
+            Append(std::move(item));
             return;
         }
         
@@ -135,10 +274,156 @@ public:
             current = current->next;
         }
         
-        current->next = new Node(item, current->next);
+        current->next = CreateNode(std::move(item), current->next);
+        size++;
+    }
+
+    template <typename Construct>
+    void AppendWith(const Construct& construct) {
+        Node* newNode = CreateNode(std::in_place, construct, nullptr);
+        if (!head) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            tail = newNode;
+        }
+        size++;
+    }
+
+    template <typename Construct>
+    void PrependWith(const Construct& construct) {
+        head = CreateNode(std::in_place, construct, head);
+        if (!tail) tail = head;
+        size++;
+    }
+
+    template <typename Construct>
+    void InsertAtWith(const Construct& construct, int index) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        if (index == 0) {
+            PrependWith(construct);
+            return;
+        }
+        if (index == size) {
+            AppendWith(construct);
+            return;
+        }
+
+        Node* current = head;
+        for (int i = 0; i < index - 1; i++) {
+            current = current->next;
+        }
+
+        current->next = CreateNode(std::in_place, construct, current->next);
         size++;
     }
 
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            Append(*first);
+        }
+    }
+
+    // Builds the new nodes as a separate chain first, so a throwing copy
+    // leaves this list untouched, then links the chain in after one walk.
+    template <typename InputIt>
+    void InsertRange(int index, InputIt first, InputIt last) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        LinkedList chain;
+        chain.AppendRange(first, last);
+        if (!chain.head) return;
+
+        if (index == 0) {
+            chain.tail->next = head;
+            head = chain.head;
+        } else {
+            Node* current = head;
+            for (int i = 0; i < index - 1; i++) {
+                current = current->next;
+            }
+            chain.tail->next = current->next;
+            current->next = chain.head;
+        }
+        if (index == size) tail = chain.tail;
+        size += chain.size;
+        nodes.Absorb(std::move(chain.nodes));
+        chain.head = chain.tail = nullptr;
+        chain.size = 0;
+    }
+
+    void AppendList(const LinkedList& other) {
+        Node* current = other.head;
+        for (int i = other.size; i > 0; i--) {
+            Append(current->data);
+            current = current->next;
+        }
+    }
+
+    // Moves every node of `other` onto our tail in O(1), leaving it empty.
+    void Splice(LinkedList& other) noexcept {
+        if (this == &other || !other.head) return;
+        if (tail) {
+            tail->next = other.head;
+        } else {
+            head = other.head;
+        }
+        tail = other.tail;
+        size += other.size;
+        nodes.Absorb(std::move(other.nodes));
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    static LinkedList ConcatMove(LinkedList&& first, LinkedList&& second) noexcept {
+        LinkedList result(std::move(first));
+        result.Splice(second);
+        return result;
+    }
+
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        AppendWith([&]() { return T(std::forward<Args>(args)...); });
+    }
+
+    template <typename... Args>
+    void EmplaceFront(Args&&... args) {
+        PrependWith([&]() { return T(std::forward<Args>(args)...); });
+    }
+
+    template <typename... Args>
+    void EmplaceAt(int index, Args&&... args) {
+        InsertAtWith([&]() { return T(std::forward<Args>(args)...); }, index);
+    }
+
+    // Stable bottom-up merge sort that only relinks nodes: no element is
+    // copied or moved and nothing is allocated. bins[i] holds a sorted run
+    // of 2^i nodes that came before everything still unsorted.
+    template <typename Less>
+    void Sort(const Less& less) {
+        if (size < 2) return;
+        Node* bins[64] = {};
+        Node* current = head;
+        while (current) {
+            Node* run = current;
+            current = current->next;
+            run->next = nullptr;
+            int level = 0;
+            for (; bins[level]; level++) {
+                run = Merge(bins[level], run, less);
+                bins[level] = nullptr;
+            }
+            bins[level] = run;
+        }
+
+        Node* sorted = nullptr;
+        for (Node* bin : bins) {
+            if (bin) sorted = sorted ? Merge(bin, sorted, less) : bin;
+        }
+        head = sorted;
+        for (tail = head; tail->next; tail = tail->next) {}
+    }
+
     void Remove(int index) {
         if (size == 0) throw Errors::EmptyList();
         if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
@@ -146,7 +431,7 @@ public:
         if (index == 0) {
             Node* temp = head;
             head = head->next;
-            delete temp;
+            DestroyNode(temp);
             if (!head) tail = nullptr;
         } else {
             Node* current = head;
@@ -157,15 +442,15 @@ public:
             Node* temp = current->next;
             current->next = temp->next;
             if (temp == tail) tail = current;
-            delete temp;
+            DestroyNode(temp);
         }
         size--;
     }
 
-    LinkedList<T>* Concat(const LinkedList<T>* list) const {
+    LinkedList* Concat(const LinkedList* list) const {
         if (!list) throw Errors::NullList();
         
-        LinkedList<T>* result = new LinkedList<T>(*this);
+        LinkedList* result = new LinkedList(*this);
         if (!list->head) return result;
         
         Node* current = list->head;
@@ -1,142 +1,408 @@
 #pragma once
 #include "sequence.hpp"
 #include "linked_list.hpp"
+#include "unrolled_list.hpp"
+#include "persistent_list.hpp"
 #include "errors.hpp"
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
-template <typename T>
+// Storage is LinkedList by default; UnrolledList trades O(1) node inserts for
+// far fewer nodes to chase on At, Insert and Delete.
+template <typename T, typename Storage = LinkedList<T>>
 class ListSequence : public ISequence<T> {
 protected:
-    LinkedList<T>* list;
+    Storage list;
+
+    class ListCursor : public ISequence<T>::Cursor {
+        typename Storage::ConstIterator current;
+
+    public:
+        explicit ListCursor(typename Storage::ConstIterator current) : current(current) {}
+        const T& Current() const override { return *current; }
+        void Next() override { ++current; }
+        std::unique_ptr<typename ISequence<T>::Cursor> Clone() const override {
+            return std::make_unique<ListCursor>(*this);
+        }
+    };
 
-    ISequence<T>* CreateFromList(LinkedList<T>* lst) const {
-        return new ListSequence<T>(*lst);
+    std::unique_ptr<typename ISequence<T>::Cursor> CreateCursor() const override {
+        return std::make_unique<ListCursor>(list.begin());
+    }
+
+    ISequence<T>* CreateFromList(Storage* lst) const {
+        ISequence<T>* result = new ListSequence(std::move(*lst));
+        delete lst;
+        return result;
     }
 
 public:
-    ListSequence() : list(new LinkedList<T>()) {}
+    ListSequence() : list() {}
+
+    ListSequence(T* items, int count) : list(items, count) {}
 
-    ListSequence(T* items, int count) : list(new LinkedList<T>(items, count)) {}
+    template <typename InputIt, EnableIfIterator<InputIt> = 0>
+    ListSequence(InputIt first, InputIt last) : list() {
+        list.AppendRange(first, last);
+    }
+
+    ListSequence(const ListSequence& other) : list(other.list) {}
+
+    ListSequence(ListSequence&& other) noexcept : list(std::move(other.list)) {}
+
+    explicit ListSequence(const Storage& lst) : list(lst) {}
 
-    ListSequence(const ListSequence<T>& other) : list(new LinkedList<T>(*other.list)) {}
+    explicit ListSequence(Storage&& lst) noexcept : list(std::move(lst)) {}
 
-    explicit ListSequence(const LinkedList<T>& lst) : list(new LinkedList<T>(lst)) {}
+    ~ListSequence() override = default;
+
+    ListSequence& operator=(const ListSequence& other) {
+        list = other.list;
+        return *this;
+    }
+
+    ListSequence& operator=(ListSequence&& other) noexcept {
+        list = std::move(other.list);
+        return *this;
+    }
 
-    ~ListSequence() override {
-        delete list;
+    const T& Front() const final {
+        return list.GetFirst();
     }
 
-    T Front() const override {
-        return list->GetFirst();
+    const T& Back() const final {
+        return list.GetLast();
     }
 
-    T Back() const override {
-        return list->GetLast();
+    const T& At(int index) const final {
+        return list.Get(index);
     }
 
-    T At(int index) const override {
-        return list->Get(index);
+    T& Front() {
+        return list.GetFirst();
     }
 
-    int Size() const override {
-        return list->GetLength();
+    T& Back() {
+        return list.GetLast();
+    }
+
+    T& At(int index) {
+        return list.Get(index);
+    }
+
+    int Size() const final {
+        return list.GetLength();
+    }
+
+    bool ForEachChunk(const ChunkVisitor<T>& visit) const override {
+        return list.ForEachChunk(visit);
+    }
+
+    // Two lists walk their node chains side by side, with no virtual call
+    // per element.
+    bool Equals(const ISequence<T>* other) const override {
+        const auto* otherList = dynamic_cast<const ListSequence*>(other);
+        if (!otherList) return this->EqualElements(other);
+        if (Size() != otherList->Size()) return false;
+        return std::equal(list.begin(), list.end(), otherList->list.begin(), ISequence<T>::Same);
+    }
+
+    // Too many ways to write to a mutable list to track them all.
+    const Hashing::Fingerprint* CachedFingerprint() const override {
+        return nullptr;
     }
 
     ISequence<T>* Slice(int start, int end) const override {
-        LinkedList<T>* sub = list->GetSubList(start, end);
-        auto* result = new ListSequence<T>(*sub);
+        Storage* sub = list.GetSubList(start, end);
+        auto* result = new ListSequence(std::move(*sub));
         delete sub;
         return result;
     }
 
     ISequence<T>* Combine(const ISequence<T>* other) const override {
-        const auto* otherList = dynamic_cast<const ListSequence<T>*>(other);
+        const auto* otherList = dynamic_cast<const ListSequence*>(other);
         if (!otherList) throw Errors::TypeMismatch();
         
-        LinkedList<T>* result = list->Concat(otherList->list);
+        Storage* result = list.Concat(&otherList->list);
         return CreateFromList(result);
     }
 
+    // Destructive Combine: takes over the nodes of both sequences in O(1)
+    // and leaves them empty.
+    ISequence<T>* CombineMove(ListSequence&& other) && {
+        auto* result = new ListSequence(std::move(list));
+        result->list.Splice(other.list);
+        return result;
+    }
+
+    // Moves every element of `other` onto our end in O(1), leaving it empty.
+    ISequence<T>* Splice(ListSequence& other) {
+        list.Splice(other.list);
+        return this;
+    }
+
     ISequence<T>* AddToEnd(T item) override {
-        list->Append(item);
+        list.Append(std::move(item));
         return this;
     }
 
     ISequence<T>* AddToFront(T item) override {
-        list->Prepend(item);
+        list.Prepend(std::move(item));
         return this;
     }
 
     ISequence<T>* Insert(T item, int index) override {
-        list->InsertAt(item, index);
+        list.InsertAt(std::move(item), index);
         return this;
     }
 
     ISequence<T>* Delete(int index) override {
-        if (list->GetLength() == 0) throw Errors::EmptyContainer();
-        list->Remove(index);
+        if (list.GetLength() == 0) throw Errors::EmptyContainer();
+        list.Remove(index);
+        return this;
+    }
+
+    ISequence<T>* AddRange(const T* items, int count) override {
+        if (count < 0) throw Errors::NegativeCount();
+        list.AppendRange(items, items + count);
+        return this;
+    }
+
+    ISequence<T>* AddRange(const ISequence<T>* other) override {
+        if (const auto* otherList = dynamic_cast<const ListSequence*>(other)) {
+            list.AppendList(otherList->list);
+            return this;
+        }
+        list.AppendRange(other->begin(), other->end());
         return this;
     }
 
+    ISequence<T>* InsertRange(const T* items, int count, int index) override {
+        if (count < 0) throw Errors::NegativeCount();
+        list.InsertRange(index, items, items + count);
+        return this;
+    }
+
+    ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) override {
+        list.AppendWith(construct);
+        return this;
+    }
+
+    ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) override {
+        list.PrependWith(construct);
+        return this;
+    }
+
+    ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int index) override {
+        list.InsertAtWith(construct, index);
+        return this;
+    }
+
+    // Storage sorts are stable merge sorts, so Sort and StableSort coincide.
+    template <typename Less = std::less<>>
+    ISequence<T>* Sort(const Less& less = Less()) {
+        list.Sort(less);
+        return this;
+    }
+
+    template <typename Less = std::less<>>
+    ISequence<T>* StableSort(const Less& less = Less()) {
+        list.Sort(less);
+        return this;
+    }
+
+    ISequence<T>* SortWith(const ElementComparer<T>& less) override {
+        return Sort(less);
+    }
+
+    ISequence<T>* StableSortWith(const ElementComparer<T>& less) override {
+        return Sort(less);
+    }
+
     ISequence<T>* GetReference() override {
         return this;
     }
 
     ISequence<T>* Copy() const override {
-        return new ListSequence<T>(*this);
+        return new ListSequence(*this);
+    }
+
+    typename Storage::ConstIterator begin() const {
+        return list.begin();
+    }
+
+    typename Storage::ConstIterator end() const {
+        return list.end();
     }
 };
 
 template <typename T>
-class ImmutableListSequence : public ListSequence<T> {
-public:
-    using ListSequence<T>::ListSequence;
+using UnrolledListSequence = ListSequence<T, UnrolledList<T>>;
 
-    ISequence<T>* Combine(const ISequence<T>* other) const override {
-        const auto* otherList = dynamic_cast<const ImmutableListSequence<T>*>(other);
-        if (!otherList) throw Errors::TypeMismatch();
+// Backed by a PersistentList, so copying the sequence is O(1) and every
+// "modified" version shares all untouched nodes with the original. The list
+// is a member rather than a base, so no in-place mutator is reachable.
+template <typename T>
+class ImmutableListSequence : public ISequence<T> {
+    PersistentList<T> list;
+    Hashing::Fingerprint fingerprint;
 
-        LinkedList<T> combined;
-        for (int i = 0; i < this->Size(); ++i) {
-            combined.Append(this->At(i));
-        }
-        for (int j = 0; j < otherList->Size(); ++j) {
-            combined.Append(otherList->At(j));
+    class ListCursor : public ISequence<T>::Cursor {
+        typename PersistentList<T>::ConstIterator current;
+
+    public:
+        explicit ListCursor(typename PersistentList<T>::ConstIterator current) : current(current) {}
+        const T& Current() const override { return *current; }
+        void Next() override { ++current; }
+        std::unique_ptr<typename ISequence<T>::Cursor> Clone() const override {
+            return std::make_unique<ListCursor>(*this);
         }
+    };
+
+    std::unique_ptr<typename ISequence<T>::Cursor> CreateCursor() const override {
+        return std::make_unique<ListCursor>(list.begin());
+    }
+
+    // Applies `edit` to a copy of the list, which shares every node, and
+    // wraps the result as a new version.
+    template <typename Edit>
+    ISequence<T>* Edited(const Edit& edit) const {
+        PersistentList<T> edited(list);
+        edit(edited);
+        return new ImmutableListSequence(std::move(edited));
+    }
+
+public:
+    ImmutableListSequence() : list() {}
+
+    ImmutableListSequence(T* items, int count) : list(items, count) {}
+
+    template <typename InputIt, EnableIfIterator<InputIt> = 0>
+    ImmutableListSequence(InputIt first, InputIt last) : list() {
+        list.AppendRange(first, last);
+    }
+
+    explicit ImmutableListSequence(PersistentList<T> lst) noexcept : list(std::move(lst)) {}
+
+    const T& Front() const final {
+        return list.GetFirst();
+    }
+
+    const T& Back() const final {
+        return list.GetLast();
+    }
+
+    const T& At(int index) const final {
+        return list.Get(index);
+    }
+
+    int Size() const final {
+        return list.GetLength();
+    }
+
+    bool ForEachChunk(const ChunkVisitor<T>& visit) const override {
+        return list.ForEachChunk(visit);
+    }
+
+    // Edits build new versions, so a computed hash stays valid.
+    const Hashing::Fingerprint* CachedFingerprint() const override {
+        return &fingerprint;
+    }
 
-        return new ImmutableListSequence<T>(combined);
+    // Versions made of the same nodes are equal without a walk.
+    bool Equals(const ISequence<T>* other) const override {
+        const auto* otherList = dynamic_cast<const ImmutableListSequence*>(other);
+        if (!otherList) return this->EqualElements(other);
+        if (list.SharesContents(otherList->list)) return true;
+        if (Size() != otherList->Size()) return false;
+        return std::equal(list.begin(), list.end(), otherList->list.begin(), ISequence<T>::Same);
+    }
+
+    ISequence<T>* Slice(int start, int end) const override {
+        PersistentList<T>* sub = list.GetSubList(start, end);
+        auto* result = new ImmutableListSequence(std::move(*sub));
+        delete sub;
+        return result;
+    }
+
+    ISequence<T>* Combine(const ISequence<T>* other) const override {
+        const auto* otherList = dynamic_cast<const ImmutableListSequence*>(other);
+        if (!otherList) throw Errors::TypeMismatch();
+        return Edited([&](PersistentList<T>& edited) { edited.Splice(otherList->list); });
     }
 
     ISequence<T>* AddToEnd(T item) override {
-        auto* copy = new ImmutableListSequence<T>(*this);
-        copy->ListSequence<T>::AddToEnd(item);
-        return copy;
+        return Edited([&](PersistentList<T>& edited) { edited.Append(std::move(item)); });
     }
 
     ISequence<T>* AddToFront(T item) override {
-        auto* copy = new ImmutableListSequence<T>(*this);
-        copy->ListSequence<T>::AddToFront(item);
-        return copy;
+        return Edited([&](PersistentList<T>& edited) { edited.Prepend(std::move(item)); });
     }
 
     ISequence<T>* Insert(T item, int index) override {
-        auto* copy = new ImmutableListSequence<T>(*this);
-        copy->ListSequence<T>::Insert(item, index);
-        return copy;
+        return Edited([&](PersistentList<T>& edited) { edited.InsertAt(std::move(item), index); });
     }
 
     ISequence<T>* Delete(int index) override {
-        auto* copy = new ImmutableListSequence<T>(*this);
-        copy->ListSequence<T>::Delete(index);
-        return copy;
+        if (list.GetLength() == 0) throw Errors::EmptyContainer();
+        return Edited([&](PersistentList<T>& edited) { edited.Remove(index); });
+    }
+
+    ISequence<T>* AddRange(const T* items, int count) override {
+        if (count < 0) throw Errors::NegativeCount();
+        return Edited([&](PersistentList<T>& edited) { edited.AppendRange(items, items + count); });
+    }
+
+    ISequence<T>* AddRange(const ISequence<T>* other) override {
+        if (const auto* otherList = dynamic_cast<const ImmutableListSequence*>(other)) {
+            return Edited([&](PersistentList<T>& edited) { edited.AppendList(otherList->list); });
+        }
+        return Edited([&](PersistentList<T>& edited) { edited.AppendRange(other->begin(), other->end()); });
+    }
+
+    ISequence<T>* InsertRange(const T* items, int count, int index) override {
+        if (count < 0) throw Errors::NegativeCount();
+        return Edited([&](PersistentList<T>& edited) { edited.InsertRange(index, items, items + count); });
+    }
+
+    ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) override {
+        return Edited([&](PersistentList<T>& edited) { edited.AppendWith(construct); });
+    }
+
+    ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) override {
+        return Edited([&](PersistentList<T>& edited) { edited.PrependWith(construct); });
+    }
+
+    ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int index) override {
+        return Edited([&](PersistentList<T>& edited) { edited.InsertAtWith(construct, index); });
+    }
+
+    // The list sort is a stable merge sort, so both orders coincide.
+    ISequence<T>* SortWith(const ElementComparer<T>& less) override {
+        return Edited([&](PersistentList<T>& edited) { edited.Sort(less); });
+    }
+
+    ISequence<T>* StableSortWith(const ElementComparer<T>& less) override {
+        return SortWith(less);
     }
 
     ISequence<T>* GetReference() override {
-        return this->Copy();
+        return Copy();
     }
 
     ISequence<T>* Copy() const override {
-        return new ImmutableListSequence<T>(*this);
+        return new ImmutableListSequence(*this);
+    }
+
+    typename PersistentList<T>::ConstIterator begin() const {
+        return list.begin();
+    }
+
+    typename PersistentList<T>::ConstIterator end() const {
+        return list.end();
     }
 };
 
@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+// Slab allocator for fixed-size list nodes. Nodes are carved out of slabs of
+// growing size, freed nodes are recycled through an intrusive free list, and
+// every slab is returned at once by ReleaseAll. A pool belongs to exactly one
+// container; it is not thread-safe.
+template <typename Node>
+class NodePool {
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    static constexpr int FirstSlabSize = 8;
+    static constexpr int MaxSlabSize = 4096;
+
+    // Slot 0 of every slab links to the previous slab; the rest hold nodes.
+    Slot* slabs;
+    Slot* oldestSlab;
+    Slot* freeList;
+    Slot* cursor;
+    Slot* limit;
+    int nextSlabSize;
+
+    void AddSlab() {
+        Slot* slab = new Slot[nextSlabSize];
+        slab[0].next = slabs;
+        if (!slabs) oldestSlab = slab;
+        slabs = slab;
+        cursor = slab + 1;
+        limit = slab + nextSlabSize;
+        nextSlabSize = std::min(nextSlabSize * 2, MaxSlabSize);
+    }
+
+public:
+    static constexpr bool BulkRelease = true;
+
+    NodePool() : slabs(nullptr), oldestSlab(nullptr), freeList(nullptr), cursor(nullptr), limit(nullptr), nextSlabSize(FirstSlabSize) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept
+        : slabs(std::exchange(other.slabs, nullptr)),
+          oldestSlab(std::exchange(other.oldestSlab, nullptr)),
+          freeList(std::exchange(other.freeList, nullptr)),
+          cursor(std::exchange(other.cursor, nullptr)),
+          limit(std::exchange(other.limit, nullptr)),
+          nextSlabSize(std::exchange(other.nextSlabSize, FirstSlabSize)) {}
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            ReleaseAll();
+            slabs = std::exchange(other.slabs, nullptr);
+            oldestSlab = std::exchange(other.oldestSlab, nullptr);
+            freeList = std::exchange(other.freeList, nullptr);
+            cursor = std::exchange(other.cursor, nullptr);
+            limit = std::exchange(other.limit, nullptr);
+            nextSlabSize = std::exchange(other.nextSlabSize, FirstSlabSize);
+        }
+        return *this;
+    }
+
+    ~NodePool() {
+        ReleaseAll();
+    }
+
+    Node* Allocate() {
+        Slot* slot;
+        if (freeList) {
+            slot = freeList;
+            freeList = freeList->next;
+        } else {
+            if (cursor == limit) AddSlab();
+            slot = cursor++;
+        }
+        return reinterpret_cast<Node*>(slot->storage);
+    }
+
+    void Deallocate(Node* node) noexcept {
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+    }
+
+    // Frees every slab without touching individual nodes; any node still
+    // constructed must have been destroyed by the caller.
+    void ReleaseAll() noexcept {
+        while (slabs) {
+            Slot* previous = slabs[0].next;
+            delete[] slabs;
+            slabs = previous;
+        }
+        oldestSlab = freeList = cursor = limit = nullptr;
+        nextSlabSize = FirstSlabSize;
+    }
+
+    // Takes ownership of another pool's slabs in O(1), e.g. after its nodes
+    // were spliced into our container. Its free slots are kept until
+    // ReleaseAll.
+    void Absorb(NodePool&& other) noexcept {
+        if (!other.slabs) return;
+        other.oldestSlab[0].next = slabs;
+        if (!slabs) oldestSlab = other.oldestSlab;
+        slabs = std::exchange(other.slabs, nullptr);
+        other.oldestSlab = other.freeList = other.cursor = other.limit = nullptr;
+        other.nextSlabSize = FirstSlabSize;
+    }
+};
+
+// One heap allocation per node; every node is released individually.
+template <typename Node>
+class HeapNodeAllocator {
+public:
+    static constexpr bool BulkRelease = false;
+
+    Node* Allocate() {
+        return std::allocator<Node>().allocate(1);
+    }
+
+    void Deallocate(Node* node) noexcept {
+        std::allocator<Node>().deallocate(node, 1);
+    }
+
+    void ReleaseAll() noexcept {}
+
+    void Absorb(HeapNodeAllocator&&) noexcept {}
+};
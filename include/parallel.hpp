@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Execution policies for the Sequences:: operations, and the helpers that
+// split a range across threads.
+namespace Execution {
+
+struct SequencedPolicy {};
+
+// Runs on `threads` workers, or on one per hardware thread when it is 0.
+struct ParallelPolicy {
+    int threads = 0;
+};
+
+inline constexpr SequencedPolicy Sequenced{};
+inline constexpr ParallelPolicy Parallel{};
+
+// Fewest elements worth handing to a thread of their own.
+constexpr int ParallelGrain = 1 << 14;
+
+constexpr int PartCount(const SequencedPolicy&, int) {
+    return 1;
+}
+
+inline int PartCount(const ParallelPolicy& policy, int size) {
+    int workers = policy.threads > 0 ? policy.threads : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(workers, size / ParallelGrain));
+}
+
+// Index of the first element of `part` when `size` elements are split into
+// `parts` near-equal consecutive ranges.
+inline int PartOffset(int size, int parts, int part) {
+    return static_cast<int>(static_cast<long long>(size) * part / parts);
+}
+
+// Iterator to the start of every part. Random-access ranges are split in
+// O(parts); anything else (a list) takes one forward pass.
+template <typename It>
+std::vector<It> SplitRange(It first, int size, int parts) {
+    std::vector<It> starts;
+    starts.reserve(parts);
+    int position = 0;
+    for (int part = 0; part < parts; part++) {
+        int offset = PartOffset(size, parts, part);
+        std::advance(first, offset - position);
+        position = offset;
+        starts.push_back(first);
+    }
+    return starts;
+}
+
+// Runs task(part) for every part, each but the last on its own thread, and
+// rethrows the first exception once all of them have finished. Parts that
+// could not get a thread run on the calling one.
+template <typename Task>
+void RunParts(int parts, const Task& task) {
+    std::vector<std::exception_ptr> errors(parts);
+    auto guarded = [&](int part) {
+        try {
+            task(part);
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    try {
+        for (int part = 0; part < parts - 1; part++) {
+            workers.emplace_back(guarded, part);
+        }
+    } catch (const std::system_error&) {
+    }
+    for (int part = static_cast<int>(workers.size()); part < parts; part++) {
+        guarded(part);
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+}  // namespace Execution
@@ -0,0 +1,433 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "errors.hpp"
+
+// Persistent list with value semantics: copies are O(1) and share every
+// node, and each edit rebuilds only the nodes it has to, leaving all other
+// copies unchanged. Elements live in two reference-counted cons lists,
+// `front` in order and `back` reversed, so both ends grow in O(1).
+// Insert and Remove copy the nodes ahead of the position in whichever chain
+// holds it (cons chains only share suffixes, so no less can be copied):
+// edits near the front of `front` or the back of `back` are cheap, while an
+// edit deep inside a long chain costs O(its depth). Concat copies the
+// smaller operand and shares the other one.
+template <typename T>
+class PersistentList {
+private:
+    struct Node;
+    using Link = std::shared_ptr<Node>;
+
+    // Nodes are never modified once another list can reach them.
+    struct Node {
+        T data;
+        Link next;
+
+        Node(T data, Link next) : data(std::move(data)), next(std::move(next)) {}
+        template <typename Construct>
+        Node(std::in_place_t, const Construct& construct, Link next) : data(construct()), next(std::move(next)) {}
+    };
+
+    Link front;
+    Link back;
+    int frontSize;
+    int backSize;
+    // Last node of each chain, which holds the last (front) or the first
+    // (back) element when the other chain is empty; keeps both ends O(1).
+    const Node* frontLast;
+    const Node* backLast;
+
+    // Drops a chain iteratively; the default recursive shared_ptr teardown
+    // would overflow the stack on long lists.
+    static void Release(Link& link) noexcept {
+        while (link && link.use_count() == 1) {
+            Link next = std::move(link->next);
+            link = std::move(next);
+        }
+        link.reset();
+    }
+
+    static const Node* Walk(const Link& link, int steps) {
+        const Node* node = link.get();
+        for (int i = 0; i < steps; i++) node = node->next.get();
+        return node;
+    }
+
+    // New nodes holding the first `count` elements of `chain`, followed by `rest`.
+    static Link CopyPrefix(const Link& chain, int count, Link rest) {
+        if (count == 0) return rest;
+        const Node* source = chain.get();
+        Link first = std::make_shared<Node>(source->data, nullptr);
+        Node* last = first.get();
+        for (int i = 1; i < count; i++) {
+            source = source->next.get();
+            last->next = std::make_shared<Node>(source->data, nullptr);
+            last = last->next.get();
+        }
+        last->next = std::move(rest);
+        return first;
+    }
+
+    // Conses the reversed `back` chain of `list` onto `rest`, restoring order.
+    static Link PrependReversedBack(const PersistentList& list, Link rest) {
+        for (const Node* node = list.back.get(); node; node = node->next.get()) {
+            rest = std::make_shared<Node>(node->data, std::move(rest));
+        }
+        return rest;
+    }
+
+    // The shared link to the node `steps` hops from the head of `chain`.
+    static Link FindLink(const Link& chain, int steps) {
+        if (steps == 0) return chain;
+        return Walk(chain, steps - 1)->next;
+    }
+
+    static const Node* LastNode(const Link& chain, int size) {
+        return size == 0 ? nullptr : Walk(chain, size - 1);
+    }
+
+    // Swaps in a new chain and drops the old one through Release.
+    static void Replace(Link& link, Link value) noexcept {
+        Link old = std::exchange(link, std::move(value));
+        Release(old);
+    }
+
+    // Inserts the node built by `makeNode(rest)` at sequence position `index`,
+    // copying the nodes ahead of it in the chain that holds that position.
+    template <typename MakeNode>
+    void InsertNode(int index, const MakeNode& makeNode) {
+        if (index <= frontSize) {
+            Link node = makeNode(FindLink(front, index));
+            if (index == frontSize) frontLast = node.get();
+            Replace(front, CopyPrefix(front, index, std::move(node)));
+            frontSize++;
+        } else {
+            int position = frontSize + backSize - index;
+            Link node = makeNode(FindLink(back, position));
+            if (position == backSize) backLast = node.get();
+            Replace(back, CopyPrefix(back, position, std::move(node)));
+            backSize++;
+        }
+    }
+
+public:
+    // Walks `front`, then the `back` chain in reverse. The reversed order is
+    // only gathered once an iterator actually reaches the back chain.
+    class ConstIterator {
+        const Node* node;
+        const Node* back;
+        int backSize;
+        mutable std::shared_ptr<const std::vector<const Node*>> backward;
+        int index;
+
+        const std::vector<const Node*>& Backward() const {
+            if (!backward) {
+                auto nodes = std::make_shared<std::vector<const Node*>>(backSize);
+                const Node* current = back;
+                for (int i = backSize - 1; i >= 0; i--, current = current->next.get()) (*nodes)[i] = current;
+                backward = std::move(nodes);
+            }
+            return *backward;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : node(nullptr), back(nullptr), backSize(0), backward(), index(0) {}
+        ConstIterator(const Node* node, const Node* back, int backSize, int index)
+            : node(node), back(back), backSize(backSize), backward(), index(index) {}
+
+        reference operator*() const { return node ? node->data : Backward()[index]->data; }
+        pointer operator->() const { return &**this; }
+
+        ConstIterator& operator++() {
+            if (node) {
+                node = node->next.get();
+            } else {
+                index++;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous(*this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return node == other.node && index == other.index; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    PersistentList() : front(), back(), frontSize(0), backSize(0), frontLast(nullptr), backLast(nullptr) {}
+
+    PersistentList(T* items, int count) : PersistentList() {
+        if (count < 0) throw Errors::InvalidSize();
+        AppendRange(items, items + count);
+    }
+
+    PersistentList(const PersistentList& other) = default;
+
+    PersistentList(PersistentList&& other) noexcept
+        : front(std::move(other.front)),
+          back(std::move(other.back)),
+          frontSize(std::exchange(other.frontSize, 0)),
+          backSize(std::exchange(other.backSize, 0)),
+          frontLast(std::exchange(other.frontLast, nullptr)),
+          backLast(std::exchange(other.backLast, nullptr)) {}
+
+    ~PersistentList() {
+        Clear();
+    }
+
+    PersistentList& operator=(const PersistentList& other) {
+        if (this != &other) {
+            PersistentList copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    PersistentList& operator=(PersistentList&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            front = std::move(other.front);
+            back = std::move(other.back);
+            frontSize = std::exchange(other.frontSize, 0);
+            backSize = std::exchange(other.backSize, 0);
+            frontLast = std::exchange(other.frontLast, nullptr);
+            backLast = std::exchange(other.backLast, nullptr);
+        }
+        return *this;
+    }
+
+    void Clear() noexcept {
+        Release(front);
+        Release(back);
+        frontSize = backSize = 0;
+        frontLast = backLast = nullptr;
+    }
+
+    const T& GetFirst() const {
+        if (GetLength() == 0) throw Errors::EmptyList();
+        return front ? front->data : backLast->data;
+    }
+
+    const T& GetLast() const {
+        if (GetLength() == 0) throw Errors::EmptyList();
+        return back ? back->data : frontLast->data;
+    }
+
+    const T& Get(int index) const {
+        if (GetLength() == 0) throw Errors::EmptyList();
+        if (index < 0 || index >= GetLength()) throw Errors::IndexOutOfRange();
+        if (index < frontSize) return Walk(front, index)->data;
+        return Walk(back, frontSize + backSize - 1 - index)->data;
+    }
+
+    // A slice running to the end of the list shares its tail with us.
+    PersistentList* GetSubList(int startIndex, int endIndex) const {
+        if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex)
+            throw Errors::InvalidRange();
+
+        auto* sublist = new PersistentList();
+        if (endIndex == GetLength() - 1 && startIndex < frontSize) {
+            sublist->front = FindLink(front, startIndex);
+            sublist->frontSize = frontSize - startIndex;
+            sublist->back = back;
+            sublist->backSize = backSize;
+            sublist->frontLast = frontLast;
+            sublist->backLast = backLast;
+            return sublist;
+        }
+        ConstIterator current = begin();
+        for (int i = 0; i < startIndex; i++) ++current;
+        for (int i = startIndex; i <= endIndex; i++, ++current) {
+            sublist->Append(*current);
+        }
+        return sublist;
+    }
+
+    int GetLength() const { return frontSize + backSize; }
+
+    // True when both lists are made of the very same nodes, as copies are.
+    bool SharesContents(const PersistentList& other) const {
+        return front == other.front && back == other.back && frontSize == other.frontSize && backSize == other.backSize;
+    }
+
+    ConstIterator begin() const { return ConstIterator(front.get(), back.get(), backSize, 0); }
+
+    ConstIterator end() const { return ConstIterator(nullptr, nullptr, backSize, backSize); }
+
+    // Calls visit(items, count) once per node, in order, until it returns
+    // false; returns false if it stopped early.
+    template <typename Visit>
+    bool ForEachChunk(const Visit& visit) const {
+        for (const Node* node = front.get(); node; node = node->next.get()) {
+            if (!visit(&node->data, 1)) return false;
+        }
+        std::vector<const Node*> backward(backSize);
+        const Node* node = back.get();
+        for (int i = backSize - 1; i >= 0; i--, node = node->next.get()) backward[i] = node;
+        for (const Node* item : backward) {
+            if (!visit(&item->data, 1)) return false;
+        }
+        return true;
+    }
+
+    void Append(T item) {
+        AppendWith([&]() -> T { return std::move(item); });
+    }
+
+    void Prepend(T item) {
+        PrependWith([&]() -> T { return std::move(item); });
+    }
+
+    void InsertAt(T item, int index) {
+        InsertAtWith([&]() -> T { return std::move(item); }, index);
+    }
+
+    template <typename Construct>
+    void AppendWith(const Construct& construct) {
+        if (GetLength() == 0) {
+            PrependWith(construct);
+            return;
+        }
+        back = std::make_shared<Node>(std::in_place, construct, back);
+        if (backSize++ == 0) backLast = back.get();
+    }
+
+    template <typename Construct>
+    void PrependWith(const Construct& construct) {
+        front = std::make_shared<Node>(std::in_place, construct, front);
+        if (frontSize++ == 0) frontLast = front.get();
+    }
+
+    template <typename Construct>
+    void InsertAtWith(const Construct& construct, int index) {
+        if (index < 0 || index > GetLength()) throw Errors::IndexOutOfRange();
+        if (index == 0) {
+            PrependWith(construct);
+        } else if (index == GetLength()) {
+            AppendWith(construct);
+        } else {
+            InsertNode(index, [&](Link rest) {
+                return std::make_shared<Node>(std::in_place, construct, std::move(rest));
+            });
+        }
+    }
+
+    // Into an empty list the range goes to `front` in order, so edits near
+    // the start of a freshly built list stay cheap.
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        if (GetLength() == 0) {
+            InsertRange(0, first, last);
+            return;
+        }
+        for (; first != last; ++first) {
+            Append(*first);
+        }
+    }
+
+    template <typename InputIt>
+    void InsertRange(int index, InputIt first, InputIt last) {
+        if (index < 0 || index > GetLength()) throw Errors::IndexOutOfRange();
+        int added = 0;
+        if (index <= frontSize) {
+            Link chain;
+            Node* chainEnd = nullptr;
+            for (; first != last; ++first, added++) {
+                Link node = std::make_shared<Node>(*first, nullptr);
+                Node* created = node.get();
+                if (chainEnd) {
+                    chainEnd->next = std::move(node);
+                } else {
+                    chain = std::move(node);
+                }
+                chainEnd = created;
+            }
+            if (added == 0) return;
+            if (index == frontSize) frontLast = chainEnd;
+            chainEnd->next = FindLink(front, index);
+            Replace(front, CopyPrefix(front, index, std::move(chain)));
+            frontSize += added;
+        } else {
+            int position = frontSize + backSize - index;
+            Link chain = FindLink(back, position);
+            for (; first != last; ++first, added++) {
+                chain = std::make_shared<Node>(*first, std::move(chain));
+                if (added == 0 && position == backSize) backLast = chain.get();
+            }
+            if (added == 0) return;
+            Replace(back, CopyPrefix(back, position, std::move(chain)));
+            backSize += added;
+        }
+    }
+
+    void AppendList(const PersistentList& other) {
+        if (this == &other) {
+            PersistentList copy(other);
+            AppendList(copy);
+            return;
+        }
+        for (const T& item : other) Append(item);
+    }
+
+    // Nodes may be shared with other versions, so the sorted order is built
+    // as a fresh list.
+    template <typename Less>
+    void Sort(const Less& less) {
+        if (GetLength() < 2) return;
+        std::vector<T> items(begin(), end());
+        std::stable_sort(items.begin(), items.end(), less);
+        PersistentList sorted;
+        sorted.AppendRange(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+        *this = std::move(sorted);
+    }
+
+    void Remove(int index) {
+        if (GetLength() == 0) throw Errors::EmptyList();
+        if (index < 0 || index >= GetLength()) throw Errors::IndexOutOfRange();
+        if (index < frontSize) {
+            Replace(front, CopyPrefix(front, index, FindLink(front, index + 1)));
+            frontSize--;
+            if (index == frontSize) frontLast = LastNode(front, frontSize);
+        } else {
+            int position = frontSize + backSize - 1 - index;
+            Replace(back, CopyPrefix(back, position, FindLink(back, position + 1)));
+            backSize--;
+            if (position == backSize) backLast = LastNode(back, backSize);
+        }
+    }
+
+    // Copies whichever operand is smaller and shares the other one.
+    PersistentList* Concat(const PersistentList* list) const {
+        if (!list) throw Errors::NullList();
+        auto* result = new PersistentList(*this);
+        result->Splice(*list);
+        return result;
+    }
+
+    void Splice(const PersistentList& other) {
+        if (other.GetLength() <= GetLength()) {
+            AppendList(other);
+            return;
+        }
+        Link rest = PrependReversedBack(*this, other.front);
+        Replace(front, CopyPrefix(front, frontSize, std::move(rest)));
+        frontSize += backSize + other.frontSize;
+        frontLast = other.frontSize > 0 ? other.frontLast : LastNode(front, frontSize);
+        Replace(back, other.back);
+        backSize = other.backSize;
+        backLast = other.backLast;
+    }
+};
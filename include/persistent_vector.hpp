@@ -0,0 +1,459 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "errors.hpp"
+
+// Persistent vector with value semantics: a 32-way trie of shared, never
+// modified nodes. Copies are O(1), and every edit copies only the nodes on
+// one root-to-leaf path (O(log32 n)), leaving all other copies intact.
+//
+// Inner nodes carry cumulative size tables, as in a relaxed radix balanced
+// (RRB) tree, so nodes may be partly filled. That lets Insert and Remove
+// split or drop nodes B-tree style, Concat merge the two trees along their
+// facing spines, and Slice cut along two paths, all in O(log n), without
+// copying elements outside the touched leaves. Concat does not redistribute
+// elements between neighbouring nodes (no RRB rebalancing), so long series
+// of small concatenations leave sparser leaves than a full RRB tree would.
+template <typename T>
+class PersistentVector {
+private:
+    static constexpr int Bits = 5;
+    static constexpr int Width = 1 << Bits;
+
+    struct Node;
+    using Link = std::shared_ptr<const Node>;
+
+    struct Node {
+        std::vector<T> items;        // leaves only
+        std::vector<Link> children;  // inner nodes only
+        std::vector<int> sizes;      // sizes[k]: elements under children[0..k]
+    };
+
+    // An edited node, plus its right half if the edit overflowed it.
+    struct Edited {
+        Link first;
+        Link second;
+    };
+
+    Link root;
+    int height;  // 0 while the root is a leaf
+    int size;
+
+    PersistentVector(Link root, int height) : root(std::move(root)), height(height), size(0) {
+        if (this->root) size = Count(*this->root, height);
+        Normalize();
+    }
+
+    static int Count(const Node& node, int height) {
+        return height == 0 ? static_cast<int>(node.items.size()) : node.sizes.back();
+    }
+
+    static Link Leaf(std::vector<T> items) {
+        auto node = std::make_shared<Node>();
+        node->items = std::move(items);
+        return node;
+    }
+
+    static Link Inner(std::vector<Link> children, int height) {
+        auto node = std::make_shared<Node>();
+        node->sizes.reserve(children.size());
+        int total = 0;
+        for (const Link& child : children) {
+            total += Count(*child, height - 1);
+            node->sizes.push_back(total);
+        }
+        node->children = std::move(children);
+        return node;
+    }
+
+    // Index of the child holding element `index`, which is made relative to
+    // that child. A child holds at most Width^height elements, so the radix
+    // guess never overshoots and is exact in densely packed subtrees.
+    static int FindChild(const Node& node, int height, int& index) {
+        int child = std::min(index >> (Bits * height), static_cast<int>(node.children.size()) - 1);
+        while (node.sizes[child] <= index) child++;
+        if (child > 0) index -= node.sizes[child - 1];
+        return child;
+    }
+
+    // Splits an overfull node; an append leaves the left half full.
+    static Edited PackLeaf(std::vector<T> items, bool appended) {
+        int count = static_cast<int>(items.size());
+        if (count <= Width) return {Leaf(std::move(items)), nullptr};
+        int cut = appended ? Width : count / 2;
+        std::vector<T> rest(std::make_move_iterator(items.begin() + cut), std::make_move_iterator(items.end()));
+        items.erase(items.begin() + cut, items.end());
+        return {Leaf(std::move(items)), Leaf(std::move(rest))};
+    }
+
+    static Edited PackInner(std::vector<Link> children, int height, bool appended) {
+        int count = static_cast<int>(children.size());
+        if (count <= Width) return {Inner(std::move(children), height), nullptr};
+        int cut = appended ? Width : count / 2;
+        std::vector<Link> rest(children.begin() + cut, children.end());
+        children.erase(children.begin() + cut, children.end());
+        return {Inner(std::move(children), height), Inner(std::move(rest), height)};
+    }
+
+    template <typename Construct>
+    static Edited InsertInto(const Node& node, int height, int index, const Construct& construct) {
+        int count = Count(node, height);
+        bool appended = index == count;
+        if (height == 0) {
+            std::vector<T> items;
+            items.reserve(count + 1);
+            items.insert(items.end(), node.items.begin(), node.items.begin() + index);
+            items.push_back(construct());
+            items.insert(items.end(), node.items.begin() + index, node.items.end());
+            return PackLeaf(std::move(items), appended);
+        }
+
+        int child;
+        if (appended) {
+            child = static_cast<int>(node.children.size()) - 1;
+            index = Count(*node.children[child], height - 1);
+        } else {
+            child = FindChild(node, height, index);
+        }
+        Edited edited = InsertInto(*node.children[child], height - 1, index, construct);
+        std::vector<Link> children = node.children;
+        children[child] = std::move(edited.first);
+        if (edited.second) children.insert(children.begin() + child + 1, std::move(edited.second));
+        return PackInner(std::move(children), height, appended);
+    }
+
+    // Returns null when the node loses its last element.
+    static Link RemoveFrom(const Node& node, int height, int index) {
+        if (height == 0) {
+            if (node.items.size() == 1) return nullptr;
+            std::vector<T> items;
+            items.reserve(node.items.size() - 1);
+            items.insert(items.end(), node.items.begin(), node.items.begin() + index);
+            items.insert(items.end(), node.items.begin() + index + 1, node.items.end());
+            return Leaf(std::move(items));
+        }
+
+        int child = FindChild(node, height, index);
+        Link edited = RemoveFrom(*node.children[child], height - 1, index);
+        std::vector<Link> children = node.children;
+        if (edited) {
+            children[child] = std::move(edited);
+        } else {
+            children.erase(children.begin() + child);
+            if (children.empty()) return nullptr;
+        }
+        return Inner(std::move(children), height);
+    }
+
+    static Link Assign(const Node& node, int height, int index, T& value) {
+        auto copy = std::make_shared<Node>();
+        if (height == 0) {
+            copy->items = node.items;
+            copy->items[index] = std::move(value);
+            return copy;
+        }
+        int child = FindChild(node, height, index);
+        copy->children = node.children;
+        copy->sizes = node.sizes;
+        copy->children[child] = Assign(*node.children[child], height - 1, index, value);
+        return copy;
+    }
+
+    static Link MergeLeaves(const Node& left, const Node& right) {
+        std::vector<T> items;
+        items.reserve(left.items.size() + right.items.size());
+        items.insert(items.end(), left.items.begin(), left.items.end());
+        items.insert(items.end(), right.items.begin(), right.items.end());
+        return Leaf(std::move(items));
+    }
+
+    // Joins two trees of the same height by merging the right spine of
+    // `left` into the left spine of `right`; the result only splits in two
+    // when the merged nodes no longer fit in one.
+    static Edited MergeSpines(const Link& left, const Link& right, int height) {
+        if (height == 0) {
+            if (left->items.size() + right->items.size() <= Width) return {MergeLeaves(*left, *right), nullptr};
+            return {left, right};
+        }
+        Edited middle = MergeSpines(left->children.back(), right->children.front(), height - 1);
+        std::vector<Link> children;
+        children.reserve(left->children.size() + right->children.size());
+        children.insert(children.end(), left->children.begin(), left->children.end() - 1);
+        children.push_back(std::move(middle.first));
+        if (middle.second) children.push_back(std::move(middle.second));
+        children.insert(children.end(), right->children.begin() + 1, right->children.end());
+        return PackInner(std::move(children), height, false);
+    }
+
+    // Hangs `right`, which is shorter, off the right spine of `left`.
+    static Edited JoinRight(const Node& left, int height, const Link& right, int rightHeight) {
+        std::vector<Link> children = left.children;
+        if (height == rightHeight + 1) {
+            Edited merged = MergeSpines(children.back(), right, rightHeight);
+            children.back() = std::move(merged.first);
+            if (merged.second) children.push_back(std::move(merged.second));
+        } else {
+            Edited joined = JoinRight(*children.back(), height - 1, right, rightHeight);
+            children.back() = std::move(joined.first);
+            if (joined.second) children.push_back(std::move(joined.second));
+        }
+        return PackInner(std::move(children), height, true);
+    }
+
+    // Hangs `left`, which is shorter, off the left spine of `right`.
+    static Edited JoinLeft(const Link& left, int leftHeight, const Node& right, int height) {
+        std::vector<Link> children = right.children;
+        Edited joined = height == leftHeight + 1
+            ? MergeSpines(left, children.front(), leftHeight)
+            : JoinLeft(left, leftHeight, *children.front(), height - 1);
+        if (joined.second) {
+            children.front() = std::move(joined.second);
+            children.insert(children.begin(), std::move(joined.first));
+        } else {
+            children.front() = std::move(joined.first);
+        }
+        return PackInner(std::move(children), height, false);
+    }
+
+    // Elements [from, end) of `node`, keeping its height.
+    static Link TakeSuffix(const Link& node, int height, int from) {
+        if (from == 0) return node;
+        if (height == 0) return Leaf(std::vector<T>(node->items.begin() + from, node->items.end()));
+        int child = FindChild(*node, height, from);
+        std::vector<Link> children;
+        children.reserve(node->children.size() - child);
+        children.push_back(TakeSuffix(node->children[child], height - 1, from));
+        children.insert(children.end(), node->children.begin() + child + 1, node->children.end());
+        return Inner(std::move(children), height);
+    }
+
+    // Elements [0, to) of `node`, keeping its height; `to` must be positive.
+    static Link TakePrefix(const Link& node, int height, int to) {
+        if (to == Count(*node, height)) return node;
+        if (height == 0) return Leaf(std::vector<T>(node->items.begin(), node->items.begin() + to));
+        int last = to - 1;
+        int child = FindChild(*node, height, last);
+        std::vector<Link> children(node->children.begin(), node->children.begin() + child);
+        children.push_back(TakePrefix(node->children[child], height - 1, last + 1));
+        return Inner(std::move(children), height);
+    }
+
+    // Drops roots that have a single child, which slicing and removal leave.
+    void Normalize() {
+        while (height > 0 && root->children.size() == 1) {
+            root = root->children.front();
+            height--;
+        }
+    }
+
+    template <typename Visit>
+    static bool VisitLeaves(const Node& node, int height, const Visit& visit) {
+        if (height == 0) return visit(node.items.data(), static_cast<int>(node.items.size()));
+        for (const Link& child : node.children) {
+            if (!VisitLeaves(*child, height - 1, visit)) return false;
+        }
+        return true;
+    }
+
+    const Node* LeafAt(int& index) const {
+        const Node* node = root.get();
+        for (int level = height; level > 0; level--) {
+            node = node->children[FindChild(*node, level, index)].get();
+        }
+        return node;
+    }
+
+public:
+    class ConstIterator {
+        const PersistentVector* owner;
+        int index;
+        const T* current;
+        const T* leafEnd;
+
+        void Load() {
+            if (index >= owner->size) return;
+            int offset = index;
+            const Node* leaf = owner->LeafAt(offset);
+            current = leaf->items.data() + offset;
+            leafEnd = leaf->items.data() + leaf->items.size();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : owner(nullptr), index(0), current(nullptr), leafEnd(nullptr) {}
+        ConstIterator(const PersistentVector* owner, int index)
+            : owner(owner), index(index), current(nullptr), leafEnd(nullptr) {
+            Load();
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return current; }
+
+        ConstIterator& operator++() {
+            index++;
+            if (++current == leafEnd) Load();
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous(*this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return index == other.index; }
+        bool operator!=(const ConstIterator& other) const { return index != other.index; }
+    };
+
+    PersistentVector() : root(), height(0), size(0) {}
+
+    // Packs the range into full leaves and full inner nodes in O(n).
+    template <typename InputIt>
+    PersistentVector(InputIt first, InputIt last) : PersistentVector() {
+        std::vector<Link> level;
+        std::vector<T> items;
+        items.reserve(Width);
+        for (; first != last; ++first) {
+            items.push_back(*first);
+            if (items.size() == Width) {
+                level.push_back(Leaf(std::move(items)));
+                items = std::vector<T>();
+                items.reserve(Width);
+            }
+        }
+        if (!items.empty()) level.push_back(Leaf(std::move(items)));
+        if (level.empty()) return;
+
+        int levelHeight = 0;
+        while (level.size() > 1) {
+            std::vector<Link> parents;
+            for (std::size_t i = 0; i < level.size(); i += Width) {
+                std::size_t stop = std::min(level.size(), i + Width);
+                parents.push_back(Inner(std::vector<Link>(level.begin() + i, level.begin() + stop), levelHeight + 1));
+            }
+            level = std::move(parents);
+            levelHeight++;
+        }
+        *this = PersistentVector(std::move(level.front()), levelHeight);
+    }
+
+    PersistentVector(const PersistentVector& other) = default;
+    PersistentVector& operator=(const PersistentVector& other) = default;
+
+    PersistentVector(PersistentVector&& other) noexcept
+        : root(std::move(other.root)),
+          height(std::exchange(other.height, 0)),
+          size(std::exchange(other.size, 0)) {}
+
+    PersistentVector& operator=(PersistentVector&& other) noexcept {
+        root = std::move(other.root);
+        height = std::exchange(other.height, 0);
+        size = std::exchange(other.size, 0);
+        return *this;
+    }
+
+    int GetSize() const { return size; }
+
+    int GetHeight() const { return height; }
+
+    // True when both vectors have the same root, as copies do.
+    bool SharesContents(const PersistentVector& other) const {
+        return root == other.root && size == other.size;
+    }
+
+    // Calls visit(items, count) with each leaf, in order, until it returns
+    // false; returns false if it stopped early.
+    template <typename Visit>
+    bool ForEachChunk(const Visit& visit) const {
+        return !root || VisitLeaves(*root, height, visit);
+    }
+
+    const T& Get(int index) const {
+        if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
+        const Node* leaf = LeafAt(index);
+        return leaf->items[index];
+    }
+
+    void Set(int index, T value) {
+        if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
+        root = Assign(*root, height, index, value);
+    }
+
+    template <typename Construct>
+    void InsertWith(const Construct& construct, int index) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        if (!root) {
+            root = Leaf(std::vector<T>{construct()});
+            size = 1;
+            return;
+        }
+        Edited edited = InsertInto(*root, height, index, construct);
+        if (edited.second) {
+            root = Inner({std::move(edited.first), std::move(edited.second)}, height + 1);
+            height++;
+        } else {
+            root = std::move(edited.first);
+        }
+        size++;
+    }
+
+    void Insert(int index, T value) {
+        InsertWith([&]() -> T { return std::move(value); }, index);
+    }
+
+    void PushBack(T value) {
+        Insert(size, std::move(value));
+    }
+
+    void Remove(int index) {
+        if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
+        root = RemoveFrom(*root, height, index);
+        size--;
+        if (!root) {
+            height = 0;
+            return;
+        }
+        Normalize();
+    }
+
+    // Elements [start, end], sharing every node outside the two cut paths.
+    PersistentVector Slice(int start, int end) const {
+        if (start < 0 || end >= size || start > end) throw Errors::InvalidRange();
+        Link suffix = TakeSuffix(root, height, start);
+        return PersistentVector(TakePrefix(suffix, height, end - start + 1), height);
+    }
+
+    static PersistentVector Concat(const PersistentVector& left, const PersistentVector& right) {
+        if (left.size == 0) return right;
+        if (right.size == 0) return left;
+
+        int joinedHeight = std::max(left.height, right.height);
+        Edited joined = left.height == right.height ? MergeSpines(left.root, right.root, joinedHeight)
+            : left.height > right.height ? JoinRight(*left.root, left.height, right.root, right.height)
+            : JoinLeft(left.root, left.height, *right.root, right.height);
+        if (!joined.second) return PersistentVector(std::move(joined.first), joinedHeight);
+        return PersistentVector(Inner({std::move(joined.first), std::move(joined.second)}, joinedHeight + 1), joinedHeight + 1);
+    }
+
+    template <typename InputIt>
+    void InsertRange(int index, InputIt first, InputIt last) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        PersistentVector middle(first, last);
+        if (middle.size == 0) return;
+        PersistentVector prefix = index == 0 ? PersistentVector() : Slice(0, index - 1);
+        PersistentVector suffix = index == size ? PersistentVector() : Slice(index, size - 1);
+        *this = Concat(Concat(prefix, middle), suffix);
+    }
+
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size); }
+};
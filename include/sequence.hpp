@@ -1,19 +1,304 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include "errors.hpp"
+#include "hash.hpp"
+#include "simd.hpp"
+
+// Non-owning handle to a callable that returns a freshly built T. Because the
+// element is returned as a prvalue, implementations initialize their storage
+// straight from the call and no temporary is moved.
+template <typename T>
+class ElementConstructor {
+    const void* target;
+    T (*call)(const void*);
+
+    template <typename F>
+    static T Invoke(const void* target) {
+        return (*static_cast<const F*>(target))();
+    }
+
+public:
+    template <typename F>
+    explicit ElementConstructor(const F& construct) : target(&construct), call(&Invoke<F>) {}
+
+    T operator()() const {
+        return call(target);
+    }
+};
+
+// Non-owning handle to a callable that receives `count` contiguous elements
+// and returns false to stop the walk early.
+template <typename T>
+class ChunkVisitor {
+    const void* target;
+    bool (*call)(const void*, const T*, int);
+
+    template <typename F>
+    static bool Invoke(const void* target, const T* items, int count) {
+        return (*static_cast<const F*>(target))(items, count);
+    }
+
+public:
+    template <typename F>
+    explicit ChunkVisitor(const F& visit) : target(&visit), call(&Invoke<F>) {}
+
+    bool operator()(const T* items, int count) const {
+        return call(target, items, count);
+    }
+};
+
+// Non-owning handle to a strict weak ordering on T. Remembers whether it
+// wraps std::less, so implementations can pick a key-based sort.
+template <typename T>
+class ElementComparer {
+    const void* target;
+    bool (*call)(const void*, const T&, const T&);
+    bool natural;
+
+    template <typename F>
+    static bool Invoke(const void* target, const T& left, const T& right) {
+        return (*static_cast<const F*>(target))(left, right);
+    }
+
+public:
+    template <typename F>
+    explicit ElementComparer(const F& less)
+        : target(&less),
+          call(&Invoke<F>),
+          natural(std::is_same<F, std::less<>>::value || std::is_same<F, std::less<T>>::value) {}
+
+    bool operator()(const T& left, const T& right) const {
+        return call(target, left, right);
+    }
+
+    bool IsNaturalOrder() const {
+        return natural;
+    }
+};
+
+template <typename T, typename = void>
+struct IsEqualityComparable : std::false_type {};
+
+template <typename T>
+struct IsEqualityComparable<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+    : std::true_type {};
+
+template <typename It>
+using EnableIfIterator = std::enable_if_t<
+    std::is_convertible<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>::value, int>;
 
 template <typename T>
 class ISequence {
+protected:
+    // Position inside a concrete sequence, driven by ConstIterator.
+    class Cursor {
+    public:
+        virtual ~Cursor() = default;
+        virtual const T& Current() const = 0;
+        virtual void Next() = 0;
+        virtual std::unique_ptr<Cursor> Clone() const = 0;
+    };
+
+    class PointerCursor : public Cursor {
+        const T* current;
+
+    public:
+        explicit PointerCursor(const T* current) : current(current) {}
+        const T& Current() const override { return *current; }
+        void Next() override { ++current; }
+        std::unique_ptr<Cursor> Clone() const override { return std::make_unique<PointerCursor>(*this); }
+    };
+
+    virtual std::unique_ptr<Cursor> CreateCursor() const = 0;
+
+    // Integers, enums and pointers are equal exactly when their bytes are.
+    using IsBitwiseComparable = std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value ||
+                                                               std::is_pointer<T>::value>;
+
+    // Equals has to compile for every T, so elements without operator==
+    // throw here; operator== rejects them at compile time.
+    static bool Same(const T& left, const T& right) {
+        if constexpr (IsEqualityComparable<T>::value) {
+            return left == right;
+        } else {
+            throw Errors::TypeMismatch("Elements have no operator==");
+        }
+    }
+
+    // Compares two contiguous runs; a run is always equal to itself, which
+    // makes shared buffers O(1). Runs as short as a list node skip the
+    // kernels, which would cost more to call than the loop.
+    static bool EqualRuns(const T* left, const T* right, int count) {
+        if (left == right || count == 0) return true;
+        if (count < 16) {
+            return std::equal(left, left + count, right, Same);
+        } else if constexpr (Simd::IsVectorizable<T>::value) {
+            return Simd::Equal(left, right, count);
+        } else if constexpr (IsBitwiseComparable::value) {
+            return std::memcmp(left, right, sizeof(T) * count) == 0;
+        } else {
+            return std::equal(left, left + count, right, Same);
+        }
+    }
+
+    // Equality for any pair of implementations. If either side is one
+    // contiguous run, the other side's chunks are compared against it;
+    // otherwise this side's chunks are walked against a cursor over `other`.
+    bool EqualElements(const ISequence<T>* other) const {
+        if (Size() != other->Size()) return false;
+        const T* run = ContiguousData();
+        const ISequence<T>* rest = other;
+        if (!run) {
+            run = other->ContiguousData();
+            rest = this;
+        }
+        if (run) {
+            auto compare = [&](const T* items, int count) {
+                bool equal = EqualRuns(run, items, count);
+                run += count;
+                return equal;
+            };
+            return rest->ForEachChunk(ChunkVisitor<T>(compare));
+        }
+
+        auto right = other->begin();
+        auto compare = [&](const T* items, int count) {
+            for (int i = 0; i < count; i++, ++right) {
+                if (!Same(items[i], *right)) return false;
+            }
+            return true;
+        };
+        return ForEachChunk(ChunkVisitor<T>(compare));
+    }
+
 public:
+    // Forward iterator usable through the interface. Every step is O(1) for
+    // every implementation, unlike repeated At(i) on a list. Concrete
+    // sequences hide begin()/end() with their own non-virtual iterators.
+    class ConstIterator {
+        std::unique_ptr<Cursor> cursor;
+        int position;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : cursor(), position(0) {}
+        ConstIterator(std::unique_ptr<Cursor> cursor, int position) : cursor(std::move(cursor)), position(position) {}
+        ConstIterator(const ConstIterator& other)
+            : cursor(other.cursor ? other.cursor->Clone() : nullptr), position(other.position) {}
+        ConstIterator(ConstIterator&& other) noexcept = default;
+
+        ConstIterator& operator=(const ConstIterator& other) {
+            if (this != &other) {
+                cursor = other.cursor ? other.cursor->Clone() : nullptr;
+                position = other.position;
+            }
+            return *this;
+        }
+        ConstIterator& operator=(ConstIterator&& other) noexcept = default;
+
+        reference operator*() const { return cursor->Current(); }
+        pointer operator->() const { return &cursor->Current(); }
+
+        ConstIterator& operator++() {
+            cursor->Next();
+            ++position;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous(*this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return position == other.position; }
+        bool operator!=(const ConstIterator& other) const { return position != other.position; }
+    };
+
     virtual ~ISequence() = default;
 
-    virtual T Front() const = 0;
-    virtual T Back() const = 0;
-    virtual T At(int position) const = 0;
+    ConstIterator begin() const {
+        return ConstIterator(CreateCursor(), 0);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr, Size());
+    }
+
+    virtual const T& Front() const = 0;
+    virtual const T& Back() const = 0;
+    virtual const T& At(int position) const = 0;
     virtual int Size() const = 0;
 
+    // Passes the elements to `visit` front to back in runs of contiguous
+    // storage: the whole buffer of an array, one node of a list. A single
+    // virtual call covers the sequence. Returns false if `visit` stopped it.
+    virtual bool ForEachChunk(const ChunkVisitor<T>& visit) const = 0;
+
+    // The elements when they sit in one contiguous run, as in an array or a
+    // deque, otherwise (or when empty) nullptr. Stops after the first chunk.
+    const T* ContiguousData() const {
+        const T* data = nullptr;
+        int size = Size();
+        auto first = [&](const T* items, int count) {
+            if (count == size) data = items;
+            return false;
+        };
+        ForEachChunk(ChunkVisitor<T>(first));
+        return data;
+    }
+
+    // Element-wise equality with any other implementation. Two sequences of
+    // the same type compare their storage directly: lists walk both node
+    // chains in lockstep, and versions sharing storage are equal at once.
+    virtual bool Equals(const ISequence<T>* other) const = 0;
+
+    // Hash of the elements in order: equal sequences hash alike whatever
+    // their types. Immutable sequences keep the result, so repeated calls
+    // are O(1).
+    std::uint64_t Hash() const {
+        static_assert(Hashing::IsHashable<T>::value, "sequence elements need a std::hash specialization");
+        const Hashing::Fingerprint* cache = CachedFingerprint();
+        if (std::uint64_t known = cache ? cache->Get() : 0) return known;
+        Hashing::Hasher<T> hasher;
+        auto add = [&](const T* items, int count) {
+            hasher.Add(items, count);
+            return true;
+        };
+        ForEachChunk(ChunkVisitor<T>(add));
+        std::uint64_t hash = hasher.Finish();
+        if (cache) cache->Set(hash);
+        return hash;
+    }
+
+    // Where Hash() keeps its result, or nullptr for sequences whose elements
+    // can change in place, e.g. through a T& handed out earlier.
+    virtual const Hashing::Fingerprint* CachedFingerprint() const = 0;
+
+    template <typename F>
+    void ForEach(const F& action) const {
+        auto visit = [&](const T* items, int count) {
+            for (int i = 0; i < count; i++) action(items[i]);
+            return true;
+        };
+        ForEachChunk(ChunkVisitor<T>(visit));
+    }
+
     virtual ISequence<T>* Slice(int start_pos, int end_pos) const = 0;
     virtual ISequence<T>* Combine(const ISequence<T>* other) const = 0;
 
@@ -22,6 +307,47 @@ public:
     virtual ISequence<T>* Insert(T element, int position) = 0;
     virtual ISequence<T>* Delete(int position) = 0;
 
+    virtual ISequence<T>* AddRange(const T* items, int count) = 0;
+    virtual ISequence<T>* AddRange(const ISequence<T>* other) = 0;
+    virtual ISequence<T>* InsertRange(const T* items, int count, int position) = 0;
+
+    virtual ISequence<T>* EmplaceBackWith(const ElementConstructor<T>& construct) = 0;
+    virtual ISequence<T>* EmplaceFrontWith(const ElementConstructor<T>& construct) = 0;
+    virtual ISequence<T>* EmplaceAtWith(const ElementConstructor<T>& construct, int position) = 0;
+
+    template <typename... Args>
+    ISequence<T>* EmplaceBack(Args&&... args) {
+        auto construct = [&]() { return T(std::forward<Args>(args)...); };
+        return EmplaceBackWith(ElementConstructor<T>(construct));
+    }
+
+    template <typename... Args>
+    ISequence<T>* EmplaceFront(Args&&... args) {
+        auto construct = [&]() { return T(std::forward<Args>(args)...); };
+        return EmplaceFrontWith(ElementConstructor<T>(construct));
+    }
+
+    template <typename... Args>
+    ISequence<T>* EmplaceAt(int position, Args&&... args) {
+        auto construct = [&]() { return T(std::forward<Args>(args)...); };
+        return EmplaceAtWith(ElementConstructor<T>(construct), position);
+    }
+
+    // Ascending order under `less`. Mutable sequences sort in place and
+    // return themselves; immutable ones return a sorted copy.
+    virtual ISequence<T>* SortWith(const ElementComparer<T>& less) = 0;
+    virtual ISequence<T>* StableSortWith(const ElementComparer<T>& less) = 0;
+
+    template <typename Less = std::less<>>
+    ISequence<T>* Sort(const Less& less = Less()) {
+        return SortWith(ElementComparer<T>(less));
+    }
+
+    template <typename Less = std::less<>>
+    ISequence<T>* StableSort(const Less& less = Less()) {
+        return StableSortWith(ElementComparer<T>(less));
+    }
+
     virtual ISequence<T>* GetReference() = 0;
     virtual ISequence<T>* Copy() const = 0;
 };
@@ -36,14 +362,16 @@ ISequence<T>* operator+(const ISequence<T>& first, const ISequence<T>& second) {
 
 template<typename T>
 bool operator==(const ISequence<T>& first, const ISequence<T>& second) {
-    if (first.Size() != second.Size()) return false;
-    
-    for (int i = 0; i < first.Size(); ++i) {
-        if (first.At(i) != second.At(i)) {
-            return false;
-        }
-    }
-    return true;
+    static_assert(IsEqualityComparable<T>::value, "sequence elements need operator==");
+    if (&first == &second) return true;
+    // Different known hashes settle it without looking at the elements;
+    // only immutable sequences cache one, so it cannot be stale.
+    const Hashing::Fingerprint* left = first.CachedFingerprint();
+    const Hashing::Fingerprint* right = second.CachedFingerprint();
+    std::uint64_t leftHash = left ? left->Get() : 0;
+    std::uint64_t rightHash = right ? right->Get() : 0;
+    if (leftHash && rightHash && leftHash != rightHash) return false;
+    return first.Equals(&second);
 }
 
 template<typename T>
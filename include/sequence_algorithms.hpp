@@ -0,0 +1,507 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "array_sequence.hpp"
+#include "errors.hpp"
+#include "list_sequence.hpp"
+#include "parallel.hpp"
+#include "sequence.hpp"
+#include "simd.hpp"
+
+// Compile-time sequence concept: anything with Size() and begin()/end().
+// Every concrete sequence, SequenceView and ISequence itself qualifies.
+// On a concrete type begin()/end() are non-virtual (raw pointers for the
+// contiguous ones), so the algorithms below inline into plain loops; given
+// an ISequence they walk it with ForEachChunk, one virtual call per run.
+template <typename S, typename = void>
+struct IsSequence : std::false_type {};
+
+template <typename S>
+struct IsSequence<S, std::void_t<decltype(std::declval<const S&>().Size()),
+                                 decltype(std::declval<const S&>().begin()),
+                                 decltype(std::declval<const S&>().end())>> : std::true_type {};
+
+template <typename S>
+using SequenceElement = std::decay_t<decltype(*std::declval<const S&>().begin())>;
+
+template <typename S>
+using EnableIfSequence = std::enable_if_t<IsSequence<S>::value, int>;
+
+namespace Sequences {
+
+namespace Detail {
+
+template <typename S>
+using IsPolymorphic = std::is_same<decltype(std::declval<const S&>().begin()),
+                                   typename ISequence<SequenceElement<S>>::ConstIterator>;
+
+// Calls visit(item) on each element until it returns false; returns false
+// if it stopped early.
+template <typename S, typename Visit>
+bool VisitEach(const S& sequence, const Visit& visit) {
+    if constexpr (IsPolymorphic<S>::value) {
+        using T = SequenceElement<S>;
+        auto chunk = [&](const T* items, int count) {
+            for (int i = 0; i < count; i++) {
+                if (!visit(items[i])) return false;
+            }
+            return true;
+        };
+        return sequence.ForEachChunk(ChunkVisitor<T>(chunk));
+    } else {
+        for (const auto& item : sequence) {
+            if (!visit(item)) return false;
+        }
+        return true;
+    }
+}
+
+// Arrays and views hand out raw pointers; ISequence hands out chunks.
+template <typename S>
+using IsContiguous = std::is_same<decltype(std::declval<const S&>().begin()), const SequenceElement<S>*>;
+
+// int and double sequences whose elements come in contiguous runs, which
+// the Simd kernels take whole.
+template <typename S>
+using IsVectorized = std::integral_constant<bool, Simd::IsVectorizable<SequenceElement<S>>::value &&
+                                                      (IsContiguous<S>::value || IsPolymorphic<S>::value)>;
+
+// Signed integers are summed in their unsigned type, which wraps instead of
+// overflowing.
+template <typename T, bool = std::is_integral<T>::value && std::is_signed<T>::value>
+struct SumType {
+    using type = T;
+};
+
+template <typename T>
+struct SumType<T, true> {
+    using type = std::make_unsigned_t<T>;
+};
+
+// Calls visit(items, count) on each run until it returns false.
+template <typename S, typename Visit>
+bool VisitChunks(const S& sequence, const Visit& visit) {
+    if constexpr (IsContiguous<S>::value) {
+        return sequence.Size() == 0 || visit(sequence.begin(), sequence.Size());
+    } else {
+        return sequence.ForEachChunk(ChunkVisitor<SequenceElement<S>>(visit));
+    }
+}
+
+// The Storage of a ListSequence, void for anything else.
+template <typename T, typename Storage>
+Storage ListStorageProbe(const ListSequence<T, Storage>*);
+void ListStorageProbe(const void*);
+
+template <typename S>
+using ListStorage = decltype(ListStorageProbe(std::declval<const S*>()));
+
+template <typename S>
+using IsList = std::integral_constant<bool, !std::is_void<ListStorage<S>>::value>;
+
+// The same kind of list storage holding U instead.
+template <typename Storage, typename U>
+struct RebindList;
+
+template <typename T, template <typename> class NodeAllocator, typename U>
+struct RebindList<LinkedList<T, NodeAllocator>, U> {
+    using type = LinkedList<U, NodeAllocator>;
+};
+
+// Node capacity is derived from the element size, so U gets its own.
+template <typename T, int NodeCapacity, typename U>
+struct RebindList<UnrolledList<T, NodeCapacity>, U> {
+    using type = UnrolledList<U>;
+};
+
+template <typename T, typename U>
+struct RebindList<PersistentList<T>, U> {
+    using type = PersistentList<U>;
+};
+
+template <typename Storage, typename U>
+struct Result {
+    using type = ListSequence<U, typename RebindList<Storage, U>::type>;
+};
+
+template <typename U>
+struct Result<void, U> {
+    using type = ArraySequence<U>;
+};
+
+template <typename U>
+void ReserveFor(ArraySequence<U>& result, int size) {
+    result.Reserve(size);
+}
+
+template <typename U, typename Storage>
+void ReserveFor(ListSequence<U, Storage>&, int) {}
+
+// Appends the per-thread results in part order.
+template <typename Result, typename U>
+Result Assemble(std::vector<std::vector<U>>& pieces) {
+    Result result;
+    std::size_t total = 0;
+    for (const std::vector<U>& piece : pieces) total += piece.size();
+    ReserveFor(result, static_cast<int>(total));
+    for (std::vector<U>& piece : pieces) {
+        for (U& item : piece) {
+            auto take = [&]() -> U { return std::move(item); };
+            result.EmplaceBackWith(ElementConstructor<U>(take));
+        }
+        piece = std::vector<U>();
+    }
+    return result;
+}
+
+}  // namespace Detail
+
+// What Map, Where, Zip and FlatMap build: a ListSequence with the same kind
+// of storage from a list, an ArraySequence from anything else.
+template <typename S, typename U>
+using ResultSequence = typename Detail::Result<Detail::ListStorage<S>, U>::type;
+
+template <typename S, typename F, EnableIfSequence<S> = 0>
+void ForEach(const S& sequence, F&& action) {
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        action(item);
+        return true;
+    });
+}
+
+template <typename S, typename Accumulator, typename F, EnableIfSequence<S> = 0>
+Accumulator Reduce(const S& sequence, Accumulator initial, F&& combine) {
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        initial = combine(std::move(initial), item);
+        return true;
+    });
+    return initial;
+}
+
+// In parallel every part folds its own elements starting from `identity`,
+// and the partial results are then folded into `initial` in order, so
+// `combine` must be associative, accept two accumulators, and leave any
+// accumulator unchanged when combined with `identity` (0 for a sum, 1 for a
+// product).
+template <typename S, typename Accumulator, typename F, typename Policy, EnableIfSequence<S> = 0>
+Accumulator Reduce(const S& sequence, Accumulator initial, F&& combine, const Accumulator& identity,
+                   const Policy& policy) {
+    int size = sequence.Size();
+    int parts = Execution::PartCount(policy, size);
+    if (parts == 1) return Reduce(sequence, std::move(initial), combine);
+
+    auto starts = Execution::SplitRange(sequence.begin(), size, parts);
+    std::vector<std::optional<Accumulator>> partials(parts);
+    Execution::RunParts(parts, [&](int part) {
+        auto current = starts[part];
+        int count = Execution::PartOffset(size, parts, part + 1) - Execution::PartOffset(size, parts, part);
+        Accumulator partial(identity);
+        for (; count > 0; count--, ++current) partial = combine(std::move(partial), *current);
+        partials[part] = std::move(partial);
+    });
+    for (std::optional<Accumulator>& partial : partials) initial = combine(std::move(initial), std::move(*partial));
+    return initial;
+}
+
+template <typename S, EnableIfSequence<S> = 0>
+SequenceElement<S> Sum(const S& sequence) {
+    using T = SequenceElement<S>;
+    using Total = typename Detail::SumType<T>::type;
+    Total total{};
+    if constexpr (Detail::IsVectorized<S>::value) {
+        Detail::VisitChunks(sequence, [&](const auto* items, int count) {
+            total += static_cast<Total>(Simd::Sum(items, count));
+            return true;
+        });
+    } else {
+        Detail::VisitEach(sequence, [&](const auto& item) {
+            total += static_cast<const Total&>(item);
+            return true;
+        });
+    }
+    if constexpr (std::is_same<Total, T>::value) {
+        return total;
+    } else {
+        return static_cast<T>(total);
+    }
+}
+
+template <typename S, typename Predicate, EnableIfSequence<S> = 0>
+int CountIf(const S& sequence, Predicate&& predicate) {
+    int count = 0;
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        if (predicate(item)) count++;
+        return true;
+    });
+    return count;
+}
+
+// Position of the first element satisfying `predicate`, or -1.
+template <typename S, typename Predicate, EnableIfSequence<S> = 0>
+int FindIf(const S& sequence, Predicate&& predicate) {
+    int index = 0;
+    bool found = !Detail::VisitEach(sequence, [&](const auto& item) {
+        if (predicate(item)) return false;
+        index++;
+        return true;
+    });
+    return found ? index : -1;
+}
+
+// Number of elements equal to `value`.
+template <typename S, EnableIfSequence<S> = 0>
+int Count(const S& sequence, const SequenceElement<S>& value) {
+    if constexpr (Detail::IsVectorized<S>::value) {
+        int count = 0;
+        Detail::VisitChunks(sequence, [&](const auto* items, int size) {
+            count += Simd::CountEqual(items, size, value);
+            return true;
+        });
+        return count;
+    }
+    return CountIf(sequence, [&](const auto& item) { return item == value; });
+}
+
+template <typename S, EnableIfSequence<S> = 0>
+int IndexOf(const S& sequence, const SequenceElement<S>& value) {
+    if constexpr (Detail::IsVectorized<S>::value) {
+        int offset = 0;
+        int found = -1;
+        Detail::VisitChunks(sequence, [&](const auto* items, int count) {
+            found = Simd::FindFirst(items, count, value);
+            if (found >= 0) found += offset;
+            offset += count;
+            return found < 0;
+        });
+        return found;
+    }
+    return FindIf(sequence, [&](const auto& item) { return item == value; });
+}
+
+template <typename S, typename Predicate, EnableIfSequence<S> = 0>
+bool AnyOf(const S& sequence, Predicate&& predicate) {
+    return FindIf(sequence, predicate) != -1;
+}
+
+template <typename S, typename Predicate, EnableIfSequence<S> = 0>
+bool AllOf(const S& sequence, Predicate&& predicate) {
+    return FindIf(sequence, [&](const auto& item) { return !predicate(item); }) == -1;
+}
+
+namespace Detail {
+
+// Min or Max in natural order, one kernel call per run.
+template <bool Largest, typename S>
+const SequenceElement<S>& VectorExtreme(const S& sequence) {
+    const SequenceElement<S>* best = nullptr;
+    VisitChunks(sequence, [&](const auto* items, int count) {
+        int index = Largest ? Simd::MaxIndex(items, count) : Simd::MinIndex(items, count);
+        if (!best || (Largest ? *best < items[index] : items[index] < *best)) best = items + index;
+        return true;
+    });
+    if (!best) throw Errors::EmptyContainer();
+    return *best;
+}
+
+template <typename Less>
+using IsNaturalOrder = std::is_same<Less, std::less<>>;
+
+}  // namespace Detail
+
+// Smallest element under `less`; the first one wins ties.
+template <typename S, typename Less = std::less<>, EnableIfSequence<S> = 0>
+const SequenceElement<S>& Min(const S& sequence, Less less = Less()) {
+    if constexpr (Detail::IsVectorized<S>::value && Detail::IsNaturalOrder<Less>::value) {
+        return Detail::VectorExtreme<false>(sequence);
+    }
+    const SequenceElement<S>* best = nullptr;
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        if (!best || less(item, *best)) best = &item;
+        return true;
+    });
+    if (!best) throw Errors::EmptyContainer();
+    return *best;
+}
+
+template <typename S, typename Less = std::less<>, EnableIfSequence<S> = 0>
+const SequenceElement<S>& Max(const S& sequence, Less less = Less()) {
+    if constexpr (Detail::IsVectorized<S>::value && Detail::IsNaturalOrder<Less>::value) {
+        return Detail::VectorExtreme<true>(sequence);
+    }
+    return Min(sequence, [&](const auto& left, const auto& right) { return less(right, left); });
+}
+
+// Element-wise equality of two sequences of possibly different types.
+template <typename A, typename B, EnableIfSequence<A> = 0, EnableIfSequence<B> = 0>
+bool Equal(const A& first, const B& second) {
+    if (first.Size() != second.Size()) return false;
+    if constexpr (Detail::IsContiguous<A>::value && Detail::IsContiguous<B>::value &&
+                  std::is_same<SequenceElement<A>, SequenceElement<B>>::value &&
+                  Simd::IsVectorizable<SequenceElement<A>>::value) {
+        return Simd::Equal(first.begin(), second.begin(), first.Size());
+    }
+    auto right = second.begin();
+    return Detail::VisitEach(first, [&](const auto& item) {
+        if (!(item == *right)) return false;
+        ++right;
+        return true;
+    });
+}
+
+template <typename S, typename F, typename Policy = Execution::SequencedPolicy, EnableIfSequence<S> = 0>
+auto Map(const S& sequence, F&& transform, const Policy& policy = Policy()) {
+    using U = std::decay_t<std::invoke_result_t<F&, const SequenceElement<S>&>>;
+    using Result = ResultSequence<S, U>;
+    int size = sequence.Size();
+    int parts = Execution::PartCount(policy, size);
+    if constexpr (!Detail::IsList<S>::value && std::is_trivially_default_constructible<U>::value &&
+                  std::is_trivially_copy_assignable<U>::value) {
+        // Plain values: every part writes straight into its own slice of a
+        // result sized up front, which costs no more than a memset.
+        if (parts > 1) {
+            Result result(size);
+            U* output = &result.MutableFront();
+            auto starts = Execution::SplitRange(sequence.begin(), size, parts);
+            Execution::RunParts(parts, [&](int part) {
+                auto current = starts[part];
+                int last = Execution::PartOffset(size, parts, part + 1);
+                for (int i = Execution::PartOffset(size, parts, part); i < last; i++, ++current) {
+                    output[i] = transform(*current);
+                }
+            });
+            return result;
+        }
+    }
+
+    if (parts > 1) {
+        auto starts = Execution::SplitRange(sequence.begin(), size, parts);
+        std::vector<std::vector<U>> pieces(parts);
+        Execution::RunParts(parts, [&](int part) {
+            auto current = starts[part];
+            int count = Execution::PartOffset(size, parts, part + 1) - Execution::PartOffset(size, parts, part);
+            pieces[part].reserve(count);
+            for (; count > 0; count--, ++current) pieces[part].push_back(transform(*current));
+        });
+        return Detail::Assemble<Result>(pieces);
+    }
+
+    // Each mapped value is built directly in its slot.
+    Result result;
+    Detail::ReserveFor(result, size);
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        auto mapped = [&]() -> U { return transform(item); };
+        result.EmplaceBackWith(ElementConstructor<U>(mapped));
+        return true;
+    });
+    return result;
+}
+
+template <typename S, typename Predicate, typename Policy = Execution::SequencedPolicy, EnableIfSequence<S> = 0>
+auto Where(const S& sequence, Predicate&& predicate, const Policy& policy = Policy()) {
+    using T = SequenceElement<S>;
+    using Result = ResultSequence<S, T>;
+    int size = sequence.Size();
+    int parts = Execution::PartCount(policy, size);
+    if (parts > 1) {
+        auto starts = Execution::SplitRange(sequence.begin(), size, parts);
+        std::vector<std::vector<T>> pieces(parts);
+        Execution::RunParts(parts, [&](int part) {
+            auto current = starts[part];
+            int count = Execution::PartOffset(size, parts, part + 1) - Execution::PartOffset(size, parts, part);
+            for (; count > 0; count--, ++current) {
+                if (predicate(*current)) pieces[part].push_back(*current);
+            }
+        });
+        return Detail::Assemble<Result>(pieces);
+    }
+
+    Result result;
+    Detail::VisitEach(sequence, [&](const T& item) {
+        if (predicate(item)) result.AddToEnd(item);
+        return true;
+    });
+    return result;
+}
+
+// `transform` returns any range with begin()/end(); its elements are
+// appended in order.
+template <typename S, typename F, typename Policy = Execution::SequencedPolicy, EnableIfSequence<S> = 0>
+auto FlatMap(const S& sequence, F&& transform, const Policy& policy = Policy()) {
+    using Range = std::decay_t<std::invoke_result_t<F&, const SequenceElement<S>&>>;
+    using U = std::decay_t<decltype(*std::declval<Range&>().begin())>;
+    using Result = ResultSequence<S, U>;
+    int size = sequence.Size();
+    int parts = Execution::PartCount(policy, size);
+    if (parts > 1) {
+        auto starts = Execution::SplitRange(sequence.begin(), size, parts);
+        std::vector<std::vector<U>> pieces(parts);
+        Execution::RunParts(parts, [&](int part) {
+            auto current = starts[part];
+            int count = Execution::PartOffset(size, parts, part + 1) - Execution::PartOffset(size, parts, part);
+            for (; count > 0; count--, ++current) {
+                Range inner = transform(*current);
+                for (auto& item : inner) pieces[part].push_back(std::move(item));
+            }
+        });
+        return Detail::Assemble<Result>(pieces);
+    }
+
+    Result result;
+    Detail::VisitEach(sequence, [&](const auto& item) {
+        Range inner = transform(item);
+        for (auto& element : inner) result.AddToEnd(std::move(element));
+        return true;
+    });
+    return result;
+}
+
+// Pairs up elements at equal positions, stopping at the end of the shorter
+// sequence, and keeps combine(left, right) for each pair.
+template <typename A, typename B, typename F, typename Policy = Execution::SequencedPolicy,
+          EnableIfSequence<A> = 0, EnableIfSequence<B> = 0,
+          std::enable_if_t<std::is_invocable<F&, const SequenceElement<A>&, const SequenceElement<B>&>::value, int> = 0>
+auto Zip(const A& first, const B& second, F&& combine, const Policy& policy = Policy()) {
+    using U = std::decay_t<std::invoke_result_t<F&, const SequenceElement<A>&, const SequenceElement<B>&>>;
+    using Result = ResultSequence<A, U>;
+    int size = std::min(first.Size(), second.Size());
+    int parts = Execution::PartCount(policy, size);
+    if (parts > 1) {
+        auto lefts = Execution::SplitRange(first.begin(), size, parts);
+        auto rights = Execution::SplitRange(second.begin(), size, parts);
+        std::vector<std::vector<U>> pieces(parts);
+        Execution::RunParts(parts, [&](int part) {
+            auto left = lefts[part];
+            auto right = rights[part];
+            int count = Execution::PartOffset(size, parts, part + 1) - Execution::PartOffset(size, parts, part);
+            pieces[part].reserve(count);
+            for (; count > 0; count--, ++left, ++right) pieces[part].push_back(combine(*left, *right));
+        });
+        return Detail::Assemble<Result>(pieces);
+    }
+
+    Result result;
+    Detail::ReserveFor(result, size);
+    auto right = second.begin();
+    int remaining = size;
+    Detail::VisitEach(first, [&](const auto& left) {
+        if (remaining-- == 0) return false;
+        result.AddToEnd(combine(left, *right));
+        ++right;
+        return true;
+    });
+    return result;
+}
+
+template <typename A, typename B, typename Policy = Execution::SequencedPolicy,
+          EnableIfSequence<A> = 0, EnableIfSequence<B> = 0>
+auto Zip(const A& first, const B& second, const Policy& policy = Policy()) {
+    auto pair = [](const SequenceElement<A>& left, const SequenceElement<B>& right) { return std::make_pair(left, right); };
+    return Zip(first, second, pair, policy);
+}
+
+}  // namespace Sequences
@@ -0,0 +1,65 @@
+#ifndef SEQUENCE_VIEW_HPP
+#define SEQUENCE_VIEW_HPP
+
+#include "dynamic_array.hpp"
+#include "errors.hpp"
+#include <memory>
+#include <utility>
+
+// Read-only window onto a contiguous run of elements in a shared buffer.
+// The view co-owns the buffer, so it stays valid after the sequence it was
+// taken from is changed or destroyed: a sequence that still shares its
+// buffer with a view copies it before writing. Creating and slicing a view
+// are O(1).
+template <typename T>
+class SequenceView {
+    std::shared_ptr<const DynamicArray<T>> buffer;
+    const T* first;
+    int length;
+
+public:
+    SequenceView() : buffer(), first(nullptr), length(0) {}
+
+    SequenceView(std::shared_ptr<const DynamicArray<T>> buffer, int offset, int length)
+        : buffer(std::move(buffer)), first(nullptr), length(length) {
+        int available = this->buffer ? this->buffer->GetSize() : 0;
+        if (offset < 0 || length < 0 || offset + length > available) throw Errors::InvalidRange();
+        if (this->buffer) first = this->buffer->GetData() + offset;
+    }
+
+    int Size() const { return length; }
+    bool Empty() const { return length == 0; }
+
+    const T& At(int index) const {
+        if (index < 0 || index >= length) throw Errors::IndexOutOfRange();
+        return first[index];
+    }
+
+    const T& operator[](int index) const { return first[index]; }
+
+    const T& Front() const {
+        if (length == 0) throw Errors::EmptyContainer();
+        return first[0];
+    }
+
+    const T& Back() const {
+        if (length == 0) throw Errors::EmptyContainer();
+        return first[length - 1];
+    }
+
+    // Elements [start, end] of this view, sharing the same buffer.
+    SequenceView Slice(int start, int end) const {
+        if (start < 0 || end >= length || start > end) throw Errors::InvalidRange();
+        SequenceView result;
+        result.buffer = buffer;
+        result.first = first + start;
+        result.length = end - start + 1;
+        return result;
+    }
+
+    const T* Data() const { return first; }
+    const T* begin() const { return first; }
+    const T* end() const { return first + length; }
+};
+
+#endif
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SIMD_X86 1
+#define SIMD_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Vectorized kernels over contiguous runs of int or double. Every call
+// uses the widest instruction set the CPU supports, checked once per
+// process: AVX2, then SSE2 (always present on x86-64), then plain loops
+// on other targets.
+//
+// int sums wrap around on overflow. double sums add in a different order
+// than a left-to-right loop, so they may differ from it in the last bits.
+namespace Simd {
+
+enum class Level { Scalar, SSE2, AVX2 };
+
+template <typename T>
+using IsVectorizable = std::integral_constant<bool, std::is_same<T, int>::value || std::is_same<T, double>::value>;
+
+inline Level Detect() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? Level::AVX2 : Level::SSE2;
+#else
+    return Level::Scalar;
+#endif
+}
+
+inline Level Active() {
+    static const Level level = Detect();
+    return level;
+}
+
+namespace Detail {
+
+// int sums wrap around in unsigned arithmetic, since a signed overflow is
+// undefined; the vector adds wrap the same way.
+inline unsigned WrappingSum(const int* items, int count) {
+    unsigned total = 0;
+    for (int i = 0; i < count; i++) total += static_cast<unsigned>(items[i]);
+    return total;
+}
+
+inline int ScalarSum(const int* items, int count) {
+    return static_cast<int>(WrappingSum(items, count));
+}
+
+inline double ScalarSum(const double* items, int count) {
+    double total = 0;
+    for (int i = 0; i < count; i++) total += items[i];
+    return total;
+}
+
+template <bool Largest, typename T>
+T ScalarExtreme(const T* items, int count, T best) {
+    for (int i = 0; i < count; i++) {
+        if (Largest ? best < items[i] : items[i] < best) best = items[i];
+    }
+    return best;
+}
+
+template <typename T>
+int ScalarCountEqual(const T* items, int count, T value) {
+    int found = 0;
+    for (int i = 0; i < count; i++) found += items[i] == value;
+    return found;
+}
+
+template <typename T>
+int ScalarFindFirst(const T* items, int count, T value) {
+    for (int i = 0; i < count; i++) {
+        if (items[i] == value) return i;
+    }
+    return -1;
+}
+
+template <typename T>
+bool ScalarEqual(const T* left, const T* right, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!(left[i] == right[i])) return false;
+    }
+    return true;
+}
+
+#ifdef SIMD_X86
+
+// SSE2 has no 32-bit min/max, so pick lanes through a compare mask.
+inline __m128i Select(__m128i mask, __m128i taken, __m128i kept) {
+    return _mm_or_si128(_mm_and_si128(mask, taken), _mm_andnot_si128(mask, kept));
+}
+
+inline int Sse2Sum(const int* items, int count) {
+    __m128i total = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) total = _mm_add_epi32(total, _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i)));
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), total);
+    return static_cast<int>(WrappingSum(lanes, 4) + WrappingSum(items + i, count - i));
+}
+
+inline double Sse2Sum(const double* items, int count) {
+    __m128d first = _mm_setzero_pd();
+    __m128d second = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        first = _mm_add_pd(first, _mm_loadu_pd(items + i));
+        second = _mm_add_pd(second, _mm_loadu_pd(items + i + 2));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(first, second));
+    return lanes[0] + lanes[1] + ScalarSum(items + i, count - i);
+}
+
+template <bool Largest>
+int Sse2Extreme(const int* items, int count, int best) {
+    __m128i current = _mm_set1_epi32(best);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+        current = Select(Largest ? _mm_cmpgt_epi32(next, current) : _mm_cmplt_epi32(next, current), next, current);
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), current);
+    return ScalarExtreme<Largest>(items + i, count - i, ScalarExtreme<Largest>(lanes, 4, best));
+}
+
+// MINPD/MAXPD return their second operand when either is NaN, so NaN
+// elements never replace a number, as with the scalar `<` loop.
+template <bool Largest>
+double Sse2Extreme(const double* items, int count, double best) {
+    __m128d current = _mm_set1_pd(best);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d next = _mm_loadu_pd(items + i);
+        current = Largest ? _mm_max_pd(next, current) : _mm_min_pd(next, current);
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, current);
+    return ScalarExtreme<Largest>(items + i, count - i, ScalarExtreme<Largest>(lanes, 2, best));
+}
+
+inline int Sse2CountEqual(const int* items, int count, int value) {
+    __m128i target = _mm_set1_epi32(value);
+    __m128i found = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        found = _mm_sub_epi32(found, _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i)), target));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), found);
+    return ScalarSum(lanes, 4) + ScalarCountEqual(items + i, count - i, value);
+}
+
+inline int Sse2CountEqual(const double* items, int count, double value) {
+    __m128d target = _mm_set1_pd(value);
+    int found = 0;
+    int i = 0;
+    for (; i + 2 <= count; i += 2) found += __builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(items + i), target)));
+    return found + ScalarCountEqual(items + i, count - i, value);
+}
+
+inline int Sse2FindFirst(const int* items, int count, int value) {
+    __m128i target = _mm_set1_epi32(value);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i)), target);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int rest = ScalarFindFirst(items + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+inline int Sse2FindFirst(const double* items, int count, double value) {
+    __m128d target = _mm_set1_pd(value);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(items + i), target));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int rest = ScalarFindFirst(items + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+inline bool Sse2Equal(const int* left, const int* right, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF) return false;
+    }
+    return ScalarEqual(left + i, right + i, count - i);
+}
+
+inline bool Sse2Equal(const double* left, const double* right, int count) {
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i))) != 0x3) return false;
+    }
+    return ScalarEqual(left + i, right + i, count - i);
+}
+
+SIMD_AVX2 inline int Avx2Sum(const int* items, int count) {
+    __m256i total = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        total = _mm256_add_epi32(total, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i)));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return static_cast<int>(WrappingSum(lanes, 8) + WrappingSum(items + i, count - i));
+}
+
+SIMD_AVX2 inline double Avx2Sum(const double* items, int count) {
+    __m256d first = _mm256_setzero_pd();
+    __m256d second = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        first = _mm256_add_pd(first, _mm256_loadu_pd(items + i));
+        second = _mm256_add_pd(second, _mm256_loadu_pd(items + i + 4));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(first, second));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + ScalarSum(items + i, count - i);
+}
+
+template <bool Largest>
+SIMD_AVX2 int Avx2Extreme(const int* items, int count, int best) {
+    __m256i current = _mm256_set1_epi32(best);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i));
+        current = Largest ? _mm256_max_epi32(next, current) : _mm256_min_epi32(next, current);
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), current);
+    return ScalarExtreme<Largest>(items + i, count - i, ScalarExtreme<Largest>(lanes, 8, best));
+}
+
+template <bool Largest>
+SIMD_AVX2 double Avx2Extreme(const double* items, int count, double best) {
+    __m256d current = _mm256_set1_pd(best);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d next = _mm256_loadu_pd(items + i);
+        current = Largest ? _mm256_max_pd(next, current) : _mm256_min_pd(next, current);
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, current);
+    return ScalarExtreme<Largest>(items + i, count - i, ScalarExtreme<Largest>(lanes, 4, best));
+}
+
+SIMD_AVX2 inline int Avx2CountEqual(const int* items, int count, int value) {
+    __m256i target = _mm256_set1_epi32(value);
+    __m256i found = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i));
+        found = _mm256_sub_epi32(found, _mm256_cmpeq_epi32(next, target));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), found);
+    return ScalarSum(lanes, 8) + ScalarCountEqual(items + i, count - i, value);
+}
+
+SIMD_AVX2 inline int Avx2CountEqual(const double* items, int count, double value) {
+    __m256d target = _mm256_set1_pd(value);
+    int found = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        found += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(items + i), target, _CMP_EQ_OQ)));
+    }
+    return found + ScalarCountEqual(items + i, count - i, value);
+}
+
+SIMD_AVX2 inline int Avx2FindFirst(const int* items, int count, int value) {
+    __m256i target = _mm256_set1_epi32(value);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int rest = ScalarFindFirst(items + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+SIMD_AVX2 inline int Avx2FindFirst(const double* items, int count, double value) {
+    __m256d target = _mm256_set1_pd(value);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(items + i), target, _CMP_EQ_OQ));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int rest = ScalarFindFirst(items + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+SIMD_AVX2 inline bool Avx2Equal(const int* left, const int* right, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i)),
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i)));
+        if (_mm256_movemask_epi8(equal) != -1) return false;
+    }
+    return ScalarEqual(left + i, right + i, count - i);
+}
+
+SIMD_AVX2 inline bool Avx2Equal(const double* left, const double* right, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d equal = _mm256_cmp_pd(_mm256_loadu_pd(left + i), _mm256_loadu_pd(right + i), _CMP_EQ_OQ);
+        if (_mm256_movemask_pd(equal) != 0xF) return false;
+    }
+    return ScalarEqual(left + i, right + i, count - i);
+}
+
+#endif
+
+}  // namespace Detail
+
+template <typename T>
+T Sum(const T* items, int count) {
+    static_assert(IsVectorizable<T>::value, "kernels exist for int and double");
+#ifdef SIMD_X86
+    if (Active() == Level::AVX2) return Detail::Avx2Sum(items, count);
+    return Detail::Sse2Sum(items, count);
+#else
+    return Detail::ScalarSum(items, count);
+#endif
+}
+
+// Number of elements == value.
+template <typename T>
+int CountEqual(const T* items, int count, T value) {
+    static_assert(IsVectorizable<T>::value, "kernels exist for int and double");
+#ifdef SIMD_X86
+    if (Active() == Level::AVX2) return Detail::Avx2CountEqual(items, count, value);
+    return Detail::Sse2CountEqual(items, count, value);
+#else
+    return Detail::ScalarCountEqual(items, count, value);
+#endif
+}
+
+// Position of the first element == value, or -1.
+template <typename T>
+int FindFirst(const T* items, int count, T value) {
+    static_assert(IsVectorizable<T>::value, "kernels exist for int and double");
+#ifdef SIMD_X86
+    if (Active() == Level::AVX2) return Detail::Avx2FindFirst(items, count, value);
+    return Detail::Sse2FindFirst(items, count, value);
+#else
+    return Detail::ScalarFindFirst(items, count, value);
+#endif
+}
+
+// Whether left[i] == right[i] for every i; NaN never equals itself.
+template <typename T>
+bool Equal(const T* left, const T* right, int count) {
+    static_assert(IsVectorizable<T>::value, "kernels exist for int and double");
+#ifdef SIMD_X86
+    if (Active() == Level::AVX2) return Detail::Avx2Equal(left, right, count);
+    return Detail::Sse2Equal(left, right, count);
+#else
+    return Detail::ScalarEqual(left, right, count);
+#endif
+}
+
+namespace Detail {
+
+// The extreme value comes from the kernels and is then located with
+// FindFirst, so ties go to the first element.
+template <bool Largest, typename T>
+int ExtremeIndex(const T* items, int count) {
+    static_assert(IsVectorizable<T>::value, "kernels exist for int and double");
+    if (count == 0) return -1;
+    if (!(items[0] == items[0])) return 0;
+#ifdef SIMD_X86
+    T best = Active() == Level::AVX2 ? Avx2Extreme<Largest>(items, count, items[0])
+                                     : Sse2Extreme<Largest>(items, count, items[0]);
+#else
+    T best = ScalarExtreme<Largest>(items, count, items[0]);
+#endif
+    return FindFirst(items, count, best);
+}
+
+}  // namespace Detail
+
+// Positions of the first smallest and first largest element, or -1 when
+// empty. Like the `<` loop they replace, a leading NaN is the answer and
+// any other NaN is skipped.
+template <typename T>
+int MinIndex(const T* items, int count) {
+    return Detail::ExtremeIndex<false>(items, count);
+}
+
+template <typename T>
+int MaxIndex(const T* items, int count) {
+    return Detail::ExtremeIndex<true>(items, count);
+}
+
+}  // namespace Simd
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parallel.hpp"
+
+namespace Sorting {
+
+// Below this many elements a comparison sort beats the radix histograms.
+constexpr int RadixThreshold = 1 << 10;
+
+// Integral and float/double keys, which RadixBits maps onto unsigned
+// integers without changing their order.
+template <typename Key>
+using IsRadixKey = std::integral_constant<bool, (std::is_integral<Key>::value && !std::is_same<Key, bool>::value) ||
+                                                    std::is_same<Key, float>::value || std::is_same<Key, double>::value>;
+
+// Sorting by `less` is the same as sorting by radix key.
+template <typename T, typename Less>
+using UsesRadix = std::integral_constant<bool, IsRadixKey<T>::value && (std::is_same<Less, std::less<>>::value ||
+                                                                        std::is_same<Less, std::less<T>>::value)>;
+
+template <typename Key>
+auto RadixBits(Key key) {
+    if constexpr (std::is_floating_point<Key>::value) {
+        using Bits = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+        constexpr Bits Sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        if (key == 0) key = 0;  // -0.0 == 0.0, so they share a key and keep their order
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof bits);
+        return (bits & Sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | Sign);
+    } else {
+        using Bits = std::make_unsigned_t<Key>;
+        Bits bits = static_cast<Bits>(key);
+        if constexpr (std::is_signed<Key>::value) bits ^= Bits(1) << (sizeof(Bits) * 8 - 1);
+        return bits;
+    }
+}
+
+// Stable LSD radix sort of trivially copyable records by bitsOf(record),
+// one byte per pass. All histograms are gathered in a single read, and a
+// pass whose byte is the same for every record is skipped, so narrow or
+// skewed key ranges cost fewer passes.
+template <typename Record, typename BitsOf>
+void RadixSortRecords(Record* data, int size, const BitsOf& bitsOf) {
+    static_assert(std::is_trivially_copyable<Record>::value, "radix records are copied with memcpy");
+    using Bits = decltype(bitsOf(*data));
+    constexpr int Passes = sizeof(Bits);
+
+    std::vector<std::array<int, 256>> counts(Passes);
+    for (std::array<int, 256>& count : counts) count.fill(0);
+    for (int i = 0; i < size; i++) {
+        Bits bits = bitsOf(data[i]);
+        for (int pass = 0; pass < Passes; pass++) counts[pass][(bits >> (pass * 8)) & 0xFF]++;
+    }
+
+    std::vector<Record> scratch(size);
+    Record* source = data;
+    Record* target = scratch.data();
+    for (int pass = 0; pass < Passes; pass++) {
+        std::array<int, 256>& count = counts[pass];
+        if (count[(bitsOf(source[0]) >> (pass * 8)) & 0xFF] == size) continue;
+        int offset = 0;
+        for (int& bucket : count) {
+            int next = offset + bucket;
+            bucket = offset;
+            offset = next;
+        }
+        for (int i = 0; i < size; i++) {
+            target[count[(bitsOf(source[i]) >> (pass * 8)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+    if (source != data) std::memcpy(static_cast<void*>(data), source, sizeof(Record) * size);
+}
+
+// Stable sort of any elements by an arithmetic key: (key, index) pairs are
+// radix sorted, then every element is moved once into its final place.
+template <typename T, typename KeyOf>
+void RadixSortBy(T* first, int size, const KeyOf& keyOf) {
+    using Bits = decltype(RadixBits(std::invoke(keyOf, *first)));
+    struct Entry {
+        Bits bits;
+        int index;
+    };
+    std::vector<Entry> entries(size);
+    for (int i = 0; i < size; i++) entries[i] = {RadixBits(std::invoke(keyOf, first[i])), i};
+    RadixSortRecords(entries.data(), size, [](const Entry& entry) { return entry.bits; });
+
+    std::vector<T> sorted;
+    sorted.reserve(size);
+    for (const Entry& entry : entries) sorted.push_back(std::move(first[entry.index]));
+    std::move(sorted.begin(), sorted.end(), first);
+}
+
+// Sorts [first, first + size). Arithmetic elements in natural order are
+// radix sorted, which is stable. Otherwise, with several parts, each part
+// is sorted on its own thread while it is still hot in that core's cache,
+// then runs are merged pairwise, one round per level, ping-ponging through
+// one buffer. std::merge prefers the left run on ties, so the stable
+// variant stays stable across the merges.
+template <typename T, typename Less>
+void SortRange(T* first, int size, const Less& less, bool stable, int parts) {
+    if constexpr (UsesRadix<T, Less>::value) {
+        if (size >= RadixThreshold) {
+            RadixSortRecords(first, size, [](T value) { return RadixBits(value); });
+            return;
+        }
+    }
+    parts = std::max(1, std::min(parts, size / 2));
+    if (parts == 1) {
+        if (stable) {
+            std::stable_sort(first, first + size, less);
+        } else {
+            std::sort(first, first + size, less);
+        }
+        return;
+    }
+
+    Execution::RunParts(parts, [&](int part) {
+        T* begin = first + Execution::PartOffset(size, parts, part);
+        T* end = first + Execution::PartOffset(size, parts, part + 1);
+        if (stable) {
+            std::stable_sort(begin, end, less);
+        } else {
+            std::sort(begin, end, less);
+        }
+    });
+
+    std::vector<T> buffer(std::make_move_iterator(first), std::make_move_iterator(first + size));
+    T* source = buffer.data();
+    T* target = first;
+    for (int width = 1; width < parts; width *= 2) {
+        int pairs = (parts + 2 * width - 1) / (2 * width);
+        Execution::RunParts(pairs, [&](int pair) {
+            int low = pair * 2 * width;
+            int begin = Execution::PartOffset(size, parts, low);
+            int middle = Execution::PartOffset(size, parts, std::min(low + width, parts));
+            int end = Execution::PartOffset(size, parts, std::min(low + 2 * width, parts));
+            std::merge(std::make_move_iterator(source + begin), std::make_move_iterator(source + middle),
+                       std::make_move_iterator(source + middle), std::make_move_iterator(source + end),
+                       target + begin, less);
+        });
+        std::swap(source, target);
+    }
+    if (source != first) std::move(source, source + size, first);
+}
+
+// Stable sort by keyOf(element), which may be a callable or a pointer to
+// member. Arithmetic keys are radix sorted, anything else is compared.
+template <typename T, typename KeyOf>
+void SortRangeBy(T* first, int size, const KeyOf& keyOf, int parts) {
+    using Key = std::decay_t<std::invoke_result_t<const KeyOf&, const T&>>;
+    if constexpr (IsRadixKey<Key>::value) {
+        if (size >= RadixThreshold) {
+            RadixSortBy(first, size, keyOf);
+            return;
+        }
+    }
+    auto less = [&](const T& left, const T& right) { return std::invoke(keyOf, left) < std::invoke(keyOf, right); };
+    SortRange(first, size, less, true, parts);
+}
+
+}  // namespace Sorting
@@ -5,6 +5,7 @@
 #include <limits>
 #include "array_sequence.hpp"
 #include "list_sequence.hpp"
+#include "deque_sequence.hpp"
 #include "user.hpp"
 #include "errors.hpp"
 #ifdef _WIN32
@@ -120,6 +121,8 @@ SequenceWrapper<T>::SequenceWrapper(const std::string& struct_type, const std::s
     : structure_type(struct_type), data_type(type_name) {
     if (structure_type == "array") {
         sequence = new ArraySequence<T>();
+    } else if (structure_type == "deque") {
+        sequence = new DequeSequence<T>();
     } else {
         sequence = new ListSequence<T>();
     }
@@ -133,22 +136,20 @@ SequenceWrapper<T>::~SequenceWrapper() {
 template<typename T>
 void SequenceWrapper<T>::Display() const {
     std::cout << "[ ";
-    for (int i = 0; i < sequence->Size(); ++i) {
-        std::cout << sequence->At(i) << " ";
-    }
+    sequence->ForEach([](const T& item) { std::cout << item << " "; });
     std::cout << "] (Type: " << data_type << ", Structure: " << structure_type << ")\n";
 }
 
 template<typename T>
 void SequenceWrapper<T>::AddToEnd() {
     T value = GetTypedInput<T>("Enter value to add at end: ");
-    sequence->AddToEnd(value);
+    sequence->AddToEnd(std::move(value));
 }
 
 template<typename T>
 void SequenceWrapper<T>::AddToFront() {
     T value = GetTypedInput<T>("Enter value to add at front: ");
-    sequence->AddToFront(value);
+    sequence->AddToFront(std::move(value));
 }
 
 template<typename T>
@@ -158,7 +159,7 @@ void SequenceWrapper<T>::InsertElement() {
         throw Errors::InvalidPosition();
     }
     T value = GetTypedInput<T>("Enter value to insert: ");
-    sequence->Insert(value, position);
+    sequence->Insert(std::move(value), position);
 }
 
 template<typename T>
@@ -230,7 +231,8 @@ void DisplayTypeMenu() {
 void DisplayStructureMenu() {
     std::cout << "Select structure type:\n"
               << "1. Array\n"
-              << "2. List\n";
+              << "2. List\n"
+              << "3. Deque\n";
 }
 
 void DisplayMainMenu() {
@@ -324,7 +326,7 @@ void RunInterface(std::vector<ISequenceWrapper*>& sequences) {
 
                     DisplayStructureMenu();
                     int struct_choice = GetIntInput("Select structure: ");
-                    std::string struct_name = (struct_choice == 1) ? "array" : "list";
+                    std::string struct_name = (struct_choice == 1) ? "array" : (struct_choice == 3) ? "deque" : "list";
 
                     if (type_name == "int") {
                         sequences.push_back(new SequenceWrapper<int>(struct_name, type_name));
@@ -0,0 +1,488 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "errors.hpp"
+
+// Enough elements per node to fill a few cache lines, and never fewer than 8.
+template <typename T>
+constexpr int UnrolledNodeCapacity = sizeof(T) * 8 >= 256 ? 8 : static_cast<int>(256 / sizeof(T));
+
+// Singly linked list whose nodes each hold up to NodeCapacity elements in
+// raw storage. A full node splits in half on insert, and a node that drops
+// below a quarter full after a delete absorbs its successor when both fit.
+// Exposes the same interface as LinkedList so ListSequence can use either.
+template <typename T, int NodeCapacity = UnrolledNodeCapacity<T>>
+class UnrolledList {
+    static_assert(NodeCapacity >= 2, "an unrolled node must hold at least two elements");
+
+private:
+    struct Node {
+        Node* next;
+        int count;
+        alignas(T) unsigned char storage[sizeof(T) * NodeCapacity];
+
+        Node() : next(nullptr), count(0) {}
+        T* Items() { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* Items() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+    Node* head;
+    Node* tail;
+    int size;
+
+    static void DestroyNode(Node* node) noexcept {
+        std::destroy(node->Items(), node->Items() + node->count);
+        delete node;
+    }
+
+    // Shifts items [position, count) one slot right, leaving `position` raw.
+    static void OpenHole(Node* node, int position) {
+        T* items = node->Items();
+        int count = node->count;
+        if (position == count) return;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(items + position + 1), items + position, sizeof(T) * (count - position));
+        } else {
+            ::new (static_cast<void*>(items + count)) T(std::move(items[count - 1]));
+            std::move_backward(items + position, items + count - 1, items + count);
+            std::destroy_at(items + position);
+        }
+    }
+
+    // Inverse of OpenHole: shifts items (position, count] one slot left.
+    static void CloseHole(Node* node, int position) {
+        T* items = node->Items();
+        int count = node->count;
+        if (position == count) return;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(items + position), items + position + 1, sizeof(T) * (count - position));
+        } else {
+            ::new (static_cast<void*>(items + position)) T(std::move(items[position + 1]));
+            std::move(items + position + 2, items + count + 1, items + position + 1);
+            std::destroy_at(items + count);
+        }
+    }
+
+    // Moves items [position, count) into a new node linked right after `node`.
+    Node* SplitAt(Node* node, int position) {
+        Node* rest = new Node();
+        int moved = node->count - position;
+        std::uninitialized_move(node->Items() + position, node->Items() + node->count, rest->Items());
+        std::destroy(node->Items() + position, node->Items() + node->count);
+        rest->count = moved;
+        node->count = position;
+        rest->next = node->next;
+        node->next = rest;
+        if (node == tail) tail = rest;
+        return rest;
+    }
+
+    void MergeNext(Node* node) {
+        Node* next = node->next;
+        std::uninitialized_move(next->Items(), next->Items() + next->count, node->Items() + node->count);
+        node->count += next->count;
+        node->next = next->next;
+        if (next == tail) tail = node;
+        DestroyNode(next);
+    }
+
+    // Finds the node holding `index` (which must be < size) and the offset in it.
+    Node* Locate(int& index, Node** previous = nullptr) const {
+        Node* before = nullptr;
+        Node* node = head;
+        while (index >= node->count) {
+            index -= node->count;
+            before = node;
+            node = node->next;
+        }
+        if (previous) *previous = before;
+        return node;
+    }
+
+    template <typename Construct>
+    static Node* CreateNodeWith(const Construct& construct) {
+        Node* node = new Node();
+        try {
+            ::new (static_cast<void*>(node->Items())) T(construct());
+        } catch (...) {
+            delete node;
+            throw;
+        }
+        node->count = 1;
+        return node;
+    }
+
+    template <typename Construct>
+    void ConstructAt(Node* node, int position, const Construct& construct) {
+        OpenHole(node, position);
+        try {
+            ::new (static_cast<void*>(node->Items() + position)) T(construct());
+        } catch (...) {
+            CloseHole(node, position);
+            throw;
+        }
+        node->count++;
+        size++;
+    }
+
+public:
+    class ConstIterator {
+        const Node* node;
+        int offset;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit ConstIterator(const Node* node = nullptr, int offset = 0) : node(node), offset(offset) {}
+
+        reference operator*() const { return node->Items()[offset]; }
+        pointer operator->() const { return node->Items() + offset; }
+
+        ConstIterator& operator++() {
+            if (++offset == node->count) {
+                node = node->next;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous(*this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return node == other.node && offset == other.offset; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    UnrolledList() : head(nullptr), tail(nullptr), size(0) {}
+
+    UnrolledList(T* items, int count) : UnrolledList() {
+        if (count < 0) throw Errors::InvalidSize();
+        AppendRange(items, items + count);
+    }
+
+    UnrolledList(const UnrolledList& other) : UnrolledList() {
+        try {
+            AppendList(other);
+        } catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)),
+          tail(std::exchange(other.tail, nullptr)),
+          size(std::exchange(other.size, 0)) {}
+
+    ~UnrolledList() {
+        Clear();
+    }
+
+    UnrolledList& operator=(const UnrolledList& other) {
+        if (this != &other) {
+            UnrolledList copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    UnrolledList& operator=(UnrolledList&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    void Clear() noexcept {
+        Node* current = head;
+        while (current) {
+            Node* next = current->next;
+            DestroyNode(current);
+            current = next;
+        }
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    const T& GetFirst() const {
+        if (!head) throw Errors::EmptyList();
+        return head->Items()[0];
+    }
+
+    const T& GetLast() const {
+        if (!tail) throw Errors::EmptyList();
+        return tail->Items()[tail->count - 1];
+    }
+
+    const T& Get(int index) const {
+        if (!head) throw Errors::EmptyList();
+        if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
+        const Node* node = Locate(index);
+        return node->Items()[index];
+    }
+
+    T& GetFirst() {
+        return const_cast<T&>(std::as_const(*this).GetFirst());
+    }
+
+    T& GetLast() {
+        return const_cast<T&>(std::as_const(*this).GetLast());
+    }
+
+    T& Get(int index) {
+        return const_cast<T&>(std::as_const(*this).Get(index));
+    }
+
+    UnrolledList* GetSubList(int startIndex, int endIndex) const {
+        if (startIndex < 0 || endIndex >= size || startIndex > endIndex)
+            throw Errors::InvalidRange();
+
+        auto* sublist = new UnrolledList();
+        int offset = startIndex;
+        const Node* node = Locate(offset);
+        ConstIterator first(node, offset);
+        for (int i = startIndex; i <= endIndex; i++, ++first) {
+            sublist->Append(*first);
+        }
+        return sublist;
+    }
+
+    int GetLength() const { return size; }
+
+    int GetNodeCount() const {
+        int nodes = 0;
+        for (const Node* node = head; node; node = node->next) nodes++;
+        return nodes;
+    }
+
+    ConstIterator begin() const { return ConstIterator(head); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
+
+    // Calls visit(items, count) with each node's run of elements, in order,
+    // until it returns false; returns false if it stopped early.
+    template <typename Visit>
+    bool ForEachChunk(const Visit& visit) const {
+        for (const Node* node = head; node; node = node->next) {
+            if (!visit(node->Items(), node->count)) return false;
+        }
+        return true;
+    }
+
+    void Append(T item) {
+        AppendWith([&]() -> T { return std::move(item); });
+    }
+
+    void Prepend(T item) {
+        PrependWith([&]() -> T { return std::move(item); });
+    }
+
+    void InsertAt(T item, int index) {
+        InsertAtWith([&]() -> T { return std::move(item); }, index);
+    }
+
+    template <typename Construct>
+    void AppendWith(const Construct& construct) {
+        if (tail && tail->count < NodeCapacity) {
+            ::new (static_cast<void*>(tail->Items() + tail->count)) T(construct());
+            tail->count++;
+        } else {
+            Node* node = CreateNodeWith(construct);
+            if (tail) {
+                tail->next = node;
+            } else {
+                head = node;
+            }
+            tail = node;
+        }
+        size++;
+    }
+
+    template <typename Construct>
+    void PrependWith(const Construct& construct) {
+        if (head && head->count < NodeCapacity) {
+            ConstructAt(head, 0, construct);
+            return;
+        }
+        Node* node = CreateNodeWith(construct);
+        node->next = head;
+        head = node;
+        if (!tail) tail = node;
+        size++;
+    }
+
+    template <typename Construct>
+    void InsertAtWith(const Construct& construct, int index) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        if (index == size) {
+            AppendWith(construct);
+            return;
+        }
+
+        Node* node = Locate(index);
+        if (node->count == NodeCapacity) {
+            Node* rest = SplitAt(node, NodeCapacity / 2);
+            if (index > node->count) {
+                index -= node->count;
+                node = rest;
+            }
+        }
+        ConstructAt(node, index, construct);
+    }
+
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            Append(*first);
+        }
+    }
+
+    // Packs the new elements into a separate chain first, so a throwing copy
+    // leaves this list untouched, then links the chain in, splitting at most
+    // one node.
+    template <typename InputIt>
+    void InsertRange(int index, InputIt first, InputIt last) {
+        if (index < 0 || index > size) throw Errors::IndexOutOfRange();
+        UnrolledList chain;
+        chain.AppendRange(first, last);
+        if (!chain.head) return;
+
+        if (index == size) {
+            if (tail) {
+                tail->next = chain.head;
+            } else {
+                head = chain.head;
+            }
+            tail = chain.tail;
+        } else {
+            Node* previous;
+            Node* node = Locate(index, &previous);
+            if (index > 0) {
+                SplitAt(node, index);
+                previous = node;
+                node = node->next;
+            }
+            chain.tail->next = node;
+            if (previous) {
+                previous->next = chain.head;
+            } else {
+                head = chain.head;
+            }
+        }
+        size += chain.size;
+        chain.head = chain.tail = nullptr;
+        chain.size = 0;
+    }
+
+    // Appending never relocates existing elements, so this is safe even
+    // when `other` is this list.
+    void AppendList(const UnrolledList& other) {
+        ConstIterator current = other.begin();
+        for (int i = other.size; i > 0; i--, ++current) {
+            Append(*current);
+        }
+    }
+
+    // Moves every node of `other` onto our tail in O(1), leaving it empty.
+    void Splice(UnrolledList& other) noexcept {
+        if (this == &other || !other.head) return;
+        if (tail) {
+            tail->next = other.head;
+        } else {
+            head = other.head;
+        }
+        tail = other.tail;
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    static UnrolledList ConcatMove(UnrolledList&& first, UnrolledList&& second) noexcept {
+        UnrolledList result(std::move(first));
+        result.Splice(second);
+        return result;
+    }
+
+    // Elements are moved out into one buffer, stable-sorted there and moved
+    // back, so the node layout is unchanged. If `less` throws, the buffer is
+    // still moved back, but stable_sort may have held some elements in its
+    // own scratch space at that point, so the list keeps its length and only
+    // valid, unspecified values (the basic guarantee).
+    template <typename Less>
+    void Sort(const Less& less) {
+        if (size < 2) return;
+        std::vector<T> items;
+        items.reserve(size);
+        for (Node* node = head; node; node = node->next) {
+            std::move(node->Items(), node->Items() + node->count, std::back_inserter(items));
+        }
+        auto restore = [&] {
+            auto next = items.begin();
+            for (Node* node = head; node; node = node->next) {
+                std::move(next, next + node->count, node->Items());
+                next += node->count;
+            }
+        };
+        try {
+            std::stable_sort(items.begin(), items.end(), less);
+        } catch (...) {
+            restore();
+            throw;
+        }
+        restore();
+    }
+
+    void Remove(int index) {
+        if (size == 0) throw Errors::EmptyList();
+        if (index < 0 || index >= size) throw Errors::IndexOutOfRange();
+
+        Node* previous;
+        Node* node = Locate(index, &previous);
+        std::destroy_at(node->Items() + index);
+        node->count--;
+        CloseHole(node, index);
+        size--;
+
+        if (node->count == 0) {
+            if (previous) {
+                previous->next = node->next;
+            } else {
+                head = node->next;
+            }
+            if (node == tail) tail = previous;
+            delete node;
+        } else if (node->count < NodeCapacity / 4 && node->next &&
+                   node->count + node->next->count <= NodeCapacity) {
+            MergeNext(node);
+        }
+    }
+
+    UnrolledList* Concat(const UnrolledList* list) const {
+        if (!list) throw Errors::NullList();
+
+        auto* result = new UnrolledList(*this);
+        try {
+            result->AppendList(*list);
+        } catch (...) {
+            delete result;
+            throw;
+        }
+        return result;
+    }
+};
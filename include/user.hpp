@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <limits>
@@ -43,3 +45,18 @@ struct User {
         return is;
     }
 };
+
+// Hashes the fields operator== compares, so ISequence<User>::Hash works.
+namespace std {
+
+template <>
+struct hash<User> {
+    size_t operator()(const User& user) const {
+        size_t hash = std::hash<std::string>()(user.name);
+        hash ^= std::hash<int>()(user.age) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(user.id) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+}  // namespace std
@@ -2,9 +2,44 @@
 #include "catch.hpp"
 #include "array_sequence.hpp"
 #include "list_sequence.hpp"
+#include "deque_sequence.hpp"
 #include "dynamic_array.hpp"
+#include "sequence_view.hpp"
+#include "sequence_algorithms.hpp"
+#include "lazy_sequence.hpp"
 #include "linked_list.hpp"
+#include "simd.hpp"
 #include "user.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+struct Counted {
+    static int constructed;
+    Counted() { constructed++; }
+    Counted(const Counted&) { constructed++; }
+};
+
+int Counted::constructed = 0;
+
+struct Tracked {
+    static int copies;
+    static int moves;
+    int value;
+    Tracked() : value(0) {}
+    Tracked(int value) : value(value) {}
+    Tracked(const Tracked& other) : value(other.value) { copies++; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { moves++; }
+    Tracked& operator=(const Tracked& other) { value = other.value; copies++; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { value = other.value; moves++; return *this; }
+};
+
+int Tracked::copies = 0;
+int Tracked::moves = 0;
 
 TEST_CASE("DynamicArray operations") {
     SECTION("Construction and comparison") {
@@ -47,6 +82,18 @@ TEST_CASE("DynamicArray operations") {
         DynamicArray<int> expected(expectedItems, 2);
         REQUIRE(arr == expected);
     }
+
+
+    SECTION("Reserve constructs nothing") {
+        Counted::constructed = 0;
+        DynamicArray<Counted> arr(2);
+        arr.Reserve(100);
+        REQUIRE(arr.GetCapacity() == 100);
+        REQUIRE(Counted::constructed == 4);
+        arr.Resize(3);
+        REQUIRE(arr.GetCapacity() == 100);
+        REQUIRE(Counted::constructed == 5);
+    }
 }
 
 
@@ -96,6 +143,54 @@ TEST_CASE("LinkedList operations") {
         REQUIRE(combined->GetLast() == 4);
         delete combined;
     }
+
+
+    SECTION("Pooled nodes are recycled and released") {
+        LinkedList<std::string> list;
+        for (int i = 0; i < 100; i++) list.Append(std::to_string(i));
+        for (int i = 0; i < 50; i++) list.Remove(0);
+        for (int i = 0; i < 50; i++) list.Prepend(std::to_string(i));
+        std::vector<std::string> chain = {"a", "b"};
+        list.InsertRange(10, chain.begin(), chain.end());
+        REQUIRE(list.GetLength() == 102);
+        REQUIRE(list.Get(10) == "a");
+        REQUIRE(list.GetLast() == "99");
+
+        LinkedList<std::string> moved(std::move(list));
+        REQUIRE(moved.GetLength() == 102);
+        moved.Clear();
+        moved.Append("x");
+        REQUIRE(moved.GetFirst() == "x");
+    }
+
+
+    SECTION("Splice and ConcatMove") {
+        int items1[] = {1, 2};
+        int items2[] = {3, 4};
+        LinkedList<std::string> empty;
+        LinkedList<std::string> words;
+        words.Append("a");
+        empty.Splice(words);
+        REQUIRE(empty.GetLast() == "a");
+        REQUIRE(words.GetLength() == 0);
+
+        auto combined = LinkedList<int>::ConcatMove(LinkedList<int>(items1, 2), LinkedList<int>(items2, 2));
+        combined.Append(5);
+        REQUIRE(combined.GetLength() == 5);
+        REQUIRE(combined.Get(2) == 3);
+        REQUIRE(combined.GetLast() == 5);
+    }
+
+
+    SECTION("Heap node allocator") {
+        LinkedList<int, HeapNodeAllocator> list;
+        list.Append(1);
+        list.Prepend(0);
+        LinkedList<int, HeapNodeAllocator> copy(list);
+        copy.Remove(0);
+        REQUIRE(list.GetLength() == 2);
+        REQUIRE(copy.GetFirst() == 1);
+    }
 }
 
 
@@ -111,6 +206,24 @@ TEST_CASE("ArraySequence operations") {
     }
 
 
+    SECTION("Geometric growth") {
+        ArraySequence<int> seq;
+        int reallocations = 0;
+        int lastCapacity = seq.Capacity();
+        for (int i = 0; i < 1000; i++) {
+            seq.AddToEnd(i);
+            if (seq.Capacity() != lastCapacity) {
+                reallocations++;
+                lastCapacity = seq.Capacity();
+            }
+        }
+        REQUIRE(seq.Size() == 1000);
+        REQUIRE(seq.Capacity() >= 1000);
+        REQUIRE(reallocations <= 11);
+        REQUIRE(seq.At(999) == 999);
+    }
+
+
     SECTION("Slice") {
         int items[] = {1, 2, 3, 4};
         int expectedItems[] = {2, 3};
@@ -136,6 +249,56 @@ TEST_CASE("ArraySequence operations") {
 }
 
 
+TEST_CASE("Sequence views") {
+    SECTION("SliceView shares the buffer") {
+        int items[] = {1, 2, 3, 4, 5};
+        ArraySequence<int> seq(items, 5);
+        SequenceView<int> view = seq.SliceView(1, 3);
+        REQUIRE(view.Size() == 3);
+        REQUIRE(view.Front() == 2);
+        REQUIRE(view.Back() == 4);
+        REQUIRE(view.Data() == seq.begin() + 1);
+
+        SequenceView<int> inner = view.Slice(1, 2);
+        REQUIRE(inner.At(0) == 3);
+        REQUIRE_THROWS(inner.At(2));
+    }
+
+    SECTION("Copies share the buffer until one is written") {
+        int items[] = {1, 2, 3};
+        ArraySequence<int> seq(items, 3);
+        long long copiesBefore = ArraySequence<int>::BufferCopies();
+        ISequence<int>* copy = seq.Copy();
+        ArraySequence<int> assigned(seq);
+        int read = assigned.At(0) + assigned.Front() + assigned.Back();
+        REQUIRE(read == 5);
+        REQUIRE(ArraySequence<int>::BufferCopies() == copiesBefore);
+        REQUIRE(assigned.begin() == seq.begin());
+
+        copy->AddToEnd(4);
+        copy->AddToEnd(5);
+        REQUIRE(ArraySequence<int>::BufferCopies() == copiesBefore + 1);
+        REQUIRE(seq.Size() == 3);
+        REQUIRE(copy->Size() == 5);
+        REQUIRE(assigned == seq);
+        delete copy;
+    }
+
+    SECTION("Views survive writes and destruction of the sequence") {
+        auto* seq = new ArraySequence<std::string>();
+        seq->AddToEnd("a");
+        seq->AddToEnd("b");
+        SequenceView<std::string> view = seq->SliceView(0, 1);
+        seq->AddToFront("z");
+        seq->Delete(2);
+        REQUIRE(seq->At(0) == "z");
+        REQUIRE(view.At(1) == "b");
+        delete seq;
+        REQUIRE(std::vector<std::string>(view.begin(), view.end()) == std::vector<std::string>{"a", "b"});
+    }
+}
+
+
 TEST_CASE("ListSequence operations") {
     SECTION("Basic operations") {
         int items[] = {0, 1, 2};
@@ -182,6 +345,993 @@ TEST_CASE("ListSequence operations") {
     }
 }
 
+TEST_CASE("Splicing list sequences") {
+    int items1[] = {1, 2};
+    int items2[] = {3, 4};
+    int expectedItems[] = {1, 2, 3, 4};
+
+    SECTION("CombineMove steals both lists") {
+        ListSequence<int> left(items1, 2);
+        ListSequence<int> right(items2, 2);
+        auto* combined = std::move(left).CombineMove(std::move(right));
+        REQUIRE(*combined == ListSequence<int>(expectedItems, 4));
+        REQUIRE(left.Size() == 0);
+        REQUIRE(right.Size() == 0);
+        delete combined;
+    }
+
+    SECTION("Splice appends in place") {
+        UnrolledListSequence<int> left(items1, 2);
+        UnrolledListSequence<int> right(items2, 2);
+        left.Splice(right)->AddToEnd(5);
+        REQUIRE(left.Size() == 5);
+        REQUIRE(left.At(3) == 4);
+        REQUIRE(right.Size() == 0);
+    }
+}
+
+TEST_CASE("UnrolledListSequence operations") {
+    SECTION("Matches a vector under mixed edits") {
+        UnrolledListSequence<std::string> seq;
+        std::vector<std::string> expected;
+        unsigned state = 7;
+        for (int step = 0; step < 2000; step++) {
+            state = state * 1103515245u + 12345u;
+            int size = static_cast<int>(expected.size());
+            int position = size == 0 ? 0 : static_cast<int>((state >> 8) % (size + 1));
+            std::string value = std::to_string(step);
+            if ((state >> 4) % 3 != 0 || size == 0) {
+                seq.Insert(value, position);
+                expected.insert(expected.begin() + position, value);
+            } else {
+                position = position % size;
+                seq.Delete(position);
+                expected.erase(expected.begin() + position);
+            }
+        }
+        REQUIRE(seq.Size() == static_cast<int>(expected.size()));
+        REQUIRE(std::equal(seq.begin(), seq.end(), expected.begin(), expected.end()));
+        REQUIRE(seq.At(seq.Size() / 2) == expected[expected.size() / 2]);
+    }
+
+    SECTION("Nodes split when full and merge when sparse") {
+        UnrolledList<int, 4> list;
+        for (int i = 0; i < 8; i++) list.Append(i);
+        REQUIRE(list.GetNodeCount() == 2);
+        list.InsertAt(100, 1);
+        REQUIRE(list.GetNodeCount() == 3);
+        REQUIRE(list.Get(1) == 100);
+        REQUIRE(list.Get(2) == 1);
+        for (int i = 0; i < 4; i++) list.Remove(0);
+        REQUIRE(list.GetFirst() == 3);
+        REQUIRE(list.GetLength() == 5);
+        REQUIRE(list.GetNodeCount() == 2);
+    }
+
+    SECTION("Slice, Combine and InsertRange") {
+        int items[] = {1, 2, 3, 4, 5};
+        int extra[] = {8, 9};
+        UnrolledListSequence<int> seq(items, 5);
+        seq.InsertRange(extra, 2, 2);
+        auto* sub = seq.Slice(1, 4);
+        auto* combined = sub->Combine(&seq);
+        std::vector<int> expected = {2, 8, 9, 3, 1, 2, 8, 9, 3, 4, 5};
+        REQUIRE(std::equal(combined->begin(), combined->end(), expected.begin(), expected.end()));
+        delete sub;
+        delete combined;
+    }
+}
+
+TEST_CASE("ImmutableListSequence versions") {
+    SECTION("Edits leave earlier versions intact") {
+        int items[] = {1, 2, 3, 4};
+        ImmutableListSequence<int> original(items, 4);
+        ISequence<int>* front = original.AddToFront(0);
+        ISequence<int>* back = front->AddToEnd(5);
+        ISequence<int>* inserted = back->Insert(9, 3);
+        ISequence<int>* removed = inserted->Delete(5);
+
+        std::vector<int> expected = {0, 1, 2, 9, 3, 5};
+        REQUIRE(std::equal(removed->begin(), removed->end(), expected.begin(), expected.end()));
+        REQUIRE(original == ImmutableListSequence<int>(items, 4));
+        REQUIRE(front->Size() == 5);
+        REQUIRE(back->Back() == 5);
+        REQUIRE(inserted->At(3) == 9);
+        delete front;
+        delete back;
+        delete inserted;
+        delete removed;
+    }
+
+    SECTION("No in-place mutator is reachable") {
+        using Mutable = ListSequence<int, PersistentList<int>>;
+        REQUIRE_FALSE(std::is_convertible<ImmutableListSequence<int>*, Mutable*>::value);
+        REQUIRE_FALSE(std::is_convertible<ImmutableListSequence<int>&, Mutable&>::value);
+    }
+
+    SECTION("Combine shares its operands") {
+        int left[] = {1, 2};
+        int right[] = {3, 4, 5};
+        int expectedItems[] = {1, 2, 3, 4, 5};
+        ImmutableListSequence<int> first(left, 2);
+        ImmutableListSequence<int> second(right, 3);
+        ISequence<int>* combined = first.Combine(&second);
+        REQUIRE(*combined == ImmutableListSequence<int>(expectedItems, 5));
+        REQUIRE(first.Size() == 2);
+        REQUIRE(second.Size() == 3);
+        delete combined;
+    }
+
+    SECTION("Both ends stay correct as the front and back chains change") {
+        int items[] = {1, 2, 3};
+        ImmutableListSequence<int> original(items, 3);
+        ISequence<int>* trimmed = original.Delete(2);
+        ISequence<int>* grown = trimmed->AddToEnd(7);
+        ISequence<int>* shifted = grown->Delete(0);
+        ISequence<int>* headless = shifted->Delete(0);
+        ISequence<int>* single = headless->Delete(0);
+        REQUIRE(original.Back() == 3);
+        REQUIRE(trimmed->Back() == 2);
+        REQUIRE(grown->Back() == 7);
+        REQUIRE(headless->Front() == 7);
+        REQUIRE(headless->Back() == 7);
+        REQUIRE(single->Size() == 0);
+        std::vector<int> expected = {1, 2, 7};
+        REQUIRE(std::equal(grown->begin(), grown->end(), expected.begin(), expected.end()));
+        delete trimmed;
+        delete grown;
+        delete shifted;
+        delete headless;
+        delete single;
+    }
+
+    SECTION("Long version chains are released without recursion") {
+        ImmutableListSequence<int> seq;
+        ISequence<int>* current = seq.Copy();
+        for (int i = 0; i < 200000; i++) {
+            ISequence<int>* next = current->AddToFront(i);
+            delete current;
+            current = next;
+        }
+        REQUIRE(current->Front() == 199999);
+        delete current;
+    }
+}
+
+TEST_CASE("ImmutableArraySequence versions") {
+    SECTION("Edits return new versions") {
+        int items[] = {1, 2, 3};
+        ImmutableArraySequence<int> original(items, 3);
+        ISequence<int>* appended = original.AddToEnd(4);
+        ISequence<int>* inserted = appended->Insert(9, 1);
+        ISequence<int>* removed = inserted->Delete(0);
+        ISequence<int>* updated = original.Set(2, 7);
+
+        std::vector<int> expected = {9, 2, 3, 4};
+        REQUIRE(std::equal(removed->begin(), removed->end(), expected.begin(), expected.end()));
+        REQUIRE(original == ImmutableArraySequence<int>(items, 3));
+        REQUIRE(appended->Back() == 4);
+        REQUIRE(updated->At(2) == 7);
+        delete appended;
+        delete inserted;
+        delete removed;
+        delete updated;
+    }
+
+    SECTION("Large Slice and Combine") {
+        std::vector<int> values(100000);
+        std::iota(values.begin(), values.end(), 0);
+        ImmutableArraySequence<int> seq(values.begin(), values.end());
+        ISequence<int>* slice = seq.Slice(1000, 98999);
+        ISequence<int>* combined = slice->Combine(&seq);
+        REQUIRE(slice->Size() == 98000);
+        REQUIRE(slice->Front() == 1000);
+        REQUIRE(combined->Size() == 198000);
+        REQUIRE(combined->At(97999) == 98999);
+        REQUIRE(combined->At(98000) == 0);
+
+        std::vector<int> expected(values.begin() + 1000, values.begin() + 99000);
+        expected.insert(expected.end(), values.begin(), values.end());
+        REQUIRE(std::equal(combined->begin(), combined->end(), expected.begin(), expected.end()));
+        delete slice;
+        delete combined;
+    }
+
+    SECTION("Repeated Combine keeps the tree shallow") {
+        std::vector<int> values(40);
+        std::iota(values.begin(), values.end(), 0);
+        PersistentVector<int> vector(values.begin(), values.end());
+        std::vector<int> expected = values;
+        for (int i = 0; i < 5; i++) {
+            vector = PersistentVector<int>::Concat(vector, vector);
+            std::vector<int> half = expected;
+            expected.insert(expected.end(), half.begin(), half.end());
+        }
+        REQUIRE(vector.GetSize() == 1280);
+        REQUIRE(vector.GetHeight() == 2);
+        REQUIRE(std::equal(vector.begin(), vector.end(), expected.begin(), expected.end()));
+
+        PersistentVector<int> small(values.begin(), values.begin() + 3);
+        PersistentVector<int> merged = PersistentVector<int>::Concat(small, small);
+        REQUIRE(merged.GetHeight() == 0);
+        REQUIRE(merged.Get(5) == 2);
+    }
+}
+
+TEST_CASE("Move semantics") {
+    SECTION("Containers move without throwing") {
+        STATIC_REQUIRE(std::is_nothrow_move_constructible<DynamicArray<std::string>>::value);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible<ArraySequence<std::string>>::value);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible<ListSequence<std::string>>::value);
+        STATIC_REQUIRE(std::is_nothrow_move_assignable<LinkedList<std::string>>::value);
+    }
+
+    SECTION("Moved-from sequences are empty") {
+        ArraySequence<std::string> array;
+        array.AddToEnd(std::string(64, 'a'));
+        ArraySequence<std::string> movedArray(std::move(array));
+        REQUIRE(array.Size() == 0);
+        REQUIRE(movedArray.At(0) == std::string(64, 'a'));
+
+        ListSequence<std::string> list;
+        list.AddToEnd(std::string(64, 'b'));
+        ListSequence<std::string> movedList;
+        movedList = std::move(list);
+        REQUIRE(list.Size() == 0);
+        REQUIRE(movedList.Front() == std::string(64, 'b'));
+    }
+}
+
+TEST_CASE("Emplace operations") {
+    SECTION("ArraySequence constructs in place") {
+        ArraySequence<Tracked> array;
+        array.Reserve(4);
+        ISequence<Tracked>& seq = array;
+        Tracked::copies = Tracked::moves = 0;
+        seq.EmplaceBack(1);
+        seq.EmplaceBack(3);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+        seq.EmplaceAt(1, 2);
+        seq.EmplaceFront(0);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(seq.Size() == 4);
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(array.At(i).value == i);
+        }
+    }
+
+    SECTION("ListSequence constructs in node") {
+        ListSequence<User> list;
+        ISequence<User>& seq = list;
+        seq.EmplaceBack("Bob", 30);
+        seq.EmplaceFront("Alice", 25);
+        seq.EmplaceAt(1, "Carol", 41);
+        REQUIRE(seq.Size() == 3);
+        REQUIRE(seq.At(1) == User("Carol", 41));
+        REQUIRE(seq.Back() == User("Bob", 30));
+        REQUIRE_THROWS_AS(seq.EmplaceAt(5, "Dave", 1), std::out_of_range);
+    }
+}
+
+TEST_CASE("Element references") {
+    Tracked items[] = {1, 2, 3};
+
+    SECTION("Reads through the interface do not copy") {
+        ArraySequence<Tracked> array(items, 3);
+        ListSequence<Tracked> list(items, 3);
+        DequeSequence<Tracked> deque(items, 3);
+        ImmutableListSequence<Tracked> immutable(items, 3);
+        Tracked::copies = 0;
+        for (const ISequence<Tracked>* seq : {static_cast<const ISequence<Tracked>*>(&array),
+                                              static_cast<const ISequence<Tracked>*>(&list),
+                                              static_cast<const ISequence<Tracked>*>(&deque),
+                                              static_cast<const ISequence<Tracked>*>(&immutable)}) {
+            REQUIRE(seq->Front().value == 1);
+            REQUIRE(seq->At(1).value == 2);
+            REQUIRE(seq->Back().value == 3);
+        }
+        REQUIRE(Tracked::copies == 0);
+    }
+
+    SECTION("Mutable sequences hand out writable references") {
+        ArraySequence<Tracked> array(items, 3);
+        ListSequence<Tracked> list(items, 3);
+        DequeSequence<Tracked> deque(items, 3);
+        array.MutableAt(1).value = 20;
+        list.Back().value = 30;
+        deque.Front().value = 10;
+        REQUIRE(array.At(1).value == 20);
+        REQUIRE(list.At(2).value == 30);
+        REQUIRE(deque.At(0).value == 10);
+    }
+
+    SECTION("Writing through a reference detaches a shared buffer") {
+        ArraySequence<int> original;
+        original.AddToEnd(1);
+        ArraySequence<int> copy(original);
+        copy.MutableFront() = 5;
+        REQUIRE(original.Front() == 1);
+        REQUIRE(copy.Front() == 5);
+    }
+}
+
+TEST_CASE("Range operations") {
+    SECTION("ArraySequence AddRange and InsertRange") {
+        int items[] = {1, 2, 3};
+        int more[] = {7, 8};
+        int expectedItems[] = {1, 7, 8, 2, 3, 1, 2, 3};
+        ArraySequence<int> seq;
+        seq.AddRange(items, 3);
+        seq.AddRange(&seq);
+        seq.Reserve(16);
+        seq.InsertRange(more, 2, 1);
+        ArraySequence<int> expected(expectedItems, 8);
+        REQUIRE(seq == expected);
+        REQUIRE_THROWS_AS(seq.InsertRange(more, 2, 9), std::out_of_range);
+    }
+
+    SECTION("Non-trivial elements") {
+        std::string items[] = {"alpha", "beta", "gamma"};
+        ArraySequence<std::string> seq(items, items + 3);
+        seq.InsertRange(items, 2, 3);
+        seq.InsertRange(items + 2, 1, 0);
+        REQUIRE(seq.Size() == 6);
+        REQUIRE(seq.Front() == "gamma");
+        REQUIRE(seq.At(4) == "alpha");
+        REQUIRE(seq.Back() == "beta");
+    }
+
+    SECTION("ListSequence AddRange and InsertRange") {
+        std::vector<int> source = {1, 2, 3};
+        int middle[] = {9, 9};
+        int expectedItems[] = {1, 9, 9, 2, 3, 4, 5};
+        ListSequence<int> seq(source.begin(), source.end());
+        int tail[] = {4, 5};
+        ArraySequence<int> tailSeq(tail, 2);
+        seq.AddRange(&tailSeq);
+        seq.InsertRange(middle, 2, 1);
+        ListSequence<int> expected(expectedItems, 7);
+        REQUIRE(seq == expected);
+        seq.InsertRange(middle, 1, seq.Size());
+        REQUIRE(seq.Back() == 9);
+    }
+}
+
+TEST_CASE("DequeSequence operations") {
+    SECTION("Both ends grow in amortized O(1)") {
+        DequeSequence<int> seq;
+        int reallocations = 0;
+        int lastCapacity = seq.Capacity();
+        for (int i = 0; i < 1000; i++) {
+            seq.AddToEnd(i);
+            seq.AddToFront(-i - 1);
+            if (seq.Capacity() != lastCapacity) {
+                reallocations++;
+                lastCapacity = seq.Capacity();
+            }
+        }
+        REQUIRE(seq.Size() == 2000);
+        REQUIRE(reallocations <= 12);
+        REQUIRE(seq.Front() == -1000);
+        REQUIRE(seq.At(1000) == 0);
+        REQUIRE(seq.Back() == 999);
+    }
+
+    SECTION("Insert, Delete and ranges") {
+        std::string items[] = {"b", "c", "e"};
+        std::string more[] = {"x", "y"};
+        DequeSequence<std::string> seq(items, 3);
+        seq.AddToFront("a");
+        seq.Insert("d", 3);
+        seq.EmplaceAt(5, 1, 'f');
+        seq.InsertRange(more, 2, 1);
+        seq.Delete(1);
+        seq.Delete(5);
+        std::string expectedItems[] = {"a", "y", "b", "c", "d", "f"};
+        DequeSequence<std::string> expected(expectedItems, 6);
+        REQUIRE(seq == expected);
+
+        ISequence<std::string>* slice = seq.Slice(2, 4);
+        ISequence<std::string>* combined = slice->Combine(&seq);
+        REQUIRE(combined->Size() == 9);
+        REQUIRE(combined->At(2) == "d");
+        REQUIRE(combined->Back() == "f");
+        delete combined;
+        delete slice;
+        REQUIRE_THROWS_AS(seq.Delete(6), std::out_of_range);
+    }
+
+    SECTION("EmplaceAt builds mid-sequence elements in place") {
+        Tracked items[] = {1, 2, 3, 4};
+        DequeSequence<Tracked> seq(items, 4);
+        Tracked::copies = Tracked::moves = 0;
+        seq.EmplaceAt(1, 9);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 1);
+        REQUIRE(seq.At(1).value == 9);
+        REQUIRE(seq.At(2).value == 2);
+    }
+}
+
+TEST_CASE("Iterators") {
+    SECTION("Concrete sequences iterate natively") {
+        int items[] = {1, 2, 3, 4};
+        ArraySequence<int> array(items, 4);
+        ListSequence<int> list(items, 4);
+        DequeSequence<int> deque(items, 4);
+        REQUIRE(std::accumulate(array.begin(), array.end(), 0) == 10);
+        REQUIRE(std::accumulate(list.begin(), list.end(), 0) == 10);
+        REQUIRE(std::accumulate(deque.begin(), deque.end(), 0) == 10);
+        REQUIRE(array.end() - array.begin() == 4);
+    }
+
+    SECTION("Polymorphic iteration") {
+        std::string items[] = {"a", "b", "c"};
+        ListSequence<std::string> list(items, 3);
+        const ISequence<std::string>& seq = list;
+        std::string joined;
+        for (const std::string& item : seq) {
+            joined += item;
+        }
+        REQUIRE(joined == "abc");
+        auto it = seq.begin();
+        auto copy = it++;
+        REQUIRE(*copy == "a");
+        REQUIRE(*it == "b");
+        REQUIRE(it->size() == 1);
+    }
+
+    SECTION("Comparing large lists is linear") {
+        ListSequence<int> first;
+        ListSequence<int> second;
+        for (int i = 0; i < 100000; i++) {
+            first.AddToEnd(i);
+            second.AddToEnd(i);
+        }
+        REQUIRE(first == second);
+        second.AddToEnd(0);
+        first.AddToEnd(1);
+        REQUIRE(first != second);
+    }
+}
+
+TEST_CASE("Static sequence algorithms") {
+    int items[] = {4, 1, 3, 1, 5};
+
+    SECTION("Concrete and polymorphic sequences give the same answers") {
+        ArraySequence<int> array(items, 5);
+        ListSequence<int> list(items, 5);
+        DequeSequence<int> deque(items, 5);
+        const ISequence<int>& seq = list;
+        STATIC_REQUIRE(IsSequence<ArraySequence<int>>::value);
+        STATIC_REQUIRE(IsSequence<SequenceView<int>>::value);
+        STATIC_REQUIRE_FALSE(IsSequence<int>::value);
+        REQUIRE(Sequences::Sum(array) == 14);
+        REQUIRE(Sequences::Sum(seq) == 14);
+        REQUIRE(Sequences::Reduce(deque, 1, [](int product, int item) { return product * item; }) == 60);
+        REQUIRE(Sequences::CountIf(list, [](int item) { return item == 1; }) == 2);
+        REQUIRE(Sequences::IndexOf(array, 3) == 2);
+        REQUIRE(Sequences::IndexOf(seq, 7) == -1);
+        REQUIRE(Sequences::Min(deque) == 1);
+        REQUIRE(Sequences::Max(seq) == 5);
+        REQUIRE(Sequences::AllOf(array, [](int item) { return item > 0; }));
+        REQUIRE_FALSE(Sequences::AnyOf(list, [](int item) { return item > 5; }));
+        REQUIRE(Sequences::Equal(array, list));
+        REQUIRE_FALSE(Sequences::Equal(array.SliceView(1, 2), list));
+    }
+
+    SECTION("Empty sequences") {
+        ArraySequence<int> empty;
+        REQUIRE(Sequences::Sum(empty) == 0);
+        REQUIRE(Sequences::FindIf(empty, [](int) { return true; }) == -1);
+        REQUIRE_THROWS_AS(Sequences::Min(empty), std::out_of_range);
+    }
+}
+
+TEST_CASE("Vectorized kernels") {
+    SECTION("Kernels match plain loops on every tail length") {
+        for (int size = 0; size <= 40; size++) {
+            std::vector<int> ints(size);
+            std::vector<double> doubles(size);
+            for (int i = 0; i < size; i++) {
+                ints[i] = (i * 37) % 11 - 5;
+                doubles[i] = ints[i] * 0.5;
+            }
+            REQUIRE(Simd::Sum(ints.data(), size) == std::accumulate(ints.begin(), ints.end(), 0));
+            REQUIRE(Simd::Sum(doubles.data(), size) == std::accumulate(doubles.begin(), doubles.end(), 0.0));
+            REQUIRE(Simd::CountEqual(ints.data(), size, 3) == std::count(ints.begin(), ints.end(), 3));
+            REQUIRE(Simd::CountEqual(doubles.data(), size, 1.5) == std::count(doubles.begin(), doubles.end(), 1.5));
+            int found = static_cast<int>(std::find(ints.begin(), ints.end(), 4) - ints.begin());
+            REQUIRE(Simd::FindFirst(ints.data(), size, 4) == (found == size ? -1 : found));
+            REQUIRE(Simd::FindFirst(doubles.data(), size, 2.0) == (found == size ? -1 : found));
+            int lowest = static_cast<int>(std::min_element(ints.begin(), ints.end()) - ints.begin());
+            int highest = static_cast<int>(std::max_element(ints.begin(), ints.end()) - ints.begin());
+            REQUIRE(Simd::MinIndex(ints.data(), size) == (size ? lowest : -1));
+            REQUIRE(Simd::MaxIndex(doubles.data(), size) == (size ? highest : -1));
+            REQUIRE(Simd::Equal(ints.data(), ints.data(), size));
+            if (size > 0) {
+                std::vector<double> changed = doubles;
+                changed[size - 1] += 1;
+                REQUIRE_FALSE(Simd::Equal(doubles.data(), changed.data(), size));
+            }
+        }
+    }
+
+    SECTION("Wrap-around and NaN follow the plain loops") {
+        int large[] = {INT32_MAX, 1, 0, 0, 0, 0, 0, 0, 0};
+        REQUIRE(Simd::Sum(large, 9) == INT32_MIN);
+        double values[] = {2, NAN, 1, 3, NAN, 0, 5, 4, 0};
+        REQUIRE(Simd::MinIndex(values, 9) == 5);
+        REQUIRE(Simd::MaxIndex(values, 9) == 6);
+        REQUIRE(Simd::FindFirst(values, 9, double(NAN)) == -1);
+        REQUIRE_FALSE(Simd::Equal(values, values, 9));
+        double leading[] = {NAN, 1, 2, 3, 4};
+        REQUIRE(Simd::MinIndex(leading, 5) == 0);
+    }
+
+    SECTION("int sums wrap around instead of overflowing") {
+        std::vector<int> large(42, INT_MAX);
+        ArraySequence<int> array(large.data(), 42);
+        ListSequence<int> list(large.data(), 42);
+        REQUIRE(Simd::Sum(large.data(), 42) == -42);
+        REQUIRE(Sequences::Sum(array) == -42);
+        REQUIRE(Sequences::Sum(list) == -42);
+        std::vector<long long> longs(3, LLONG_MAX);
+        REQUIRE(Sequences::Sum(ArraySequence<long long>(longs.data(), 3)) == LLONG_MAX - 2);
+    }
+
+    SECTION("Sequence operations and equality use the kernels") {
+        std::vector<int> values(1000);
+        for (int i = 0; i < 1000; i++) values[i] = i % 97;
+        ArraySequence<int> array(values.data(), 1000);
+        ListSequence<int> list(values.data(), 1000);
+        DequeSequence<int> deque(values.data(), 1000);
+        const ISequence<int>& seq = list;
+        REQUIRE(Sequences::Sum(array) == std::accumulate(values.begin(), values.end(), 0));
+        REQUIRE(Sequences::Sum(seq) == Sequences::Sum(array));
+        REQUIRE(Sequences::Count(array, 5) == 11);
+        REQUIRE(Sequences::Count(seq, 96) == 10);
+        REQUIRE(Sequences::IndexOf(seq, 50) == 50);
+        REQUIRE(Sequences::IndexOf(array.SliceView(100, 999), 2) == 96);
+        REQUIRE(&Sequences::Min(array) == &array.At(0));
+        REQUIRE(&Sequences::Max(seq) == &list.At(96));
+
+        REQUIRE(array == list);
+        REQUIRE(list == deque);
+        REQUIRE(Sequences::Equal(array, array.SliceView(0, 999)));
+        list.At(999) = -1;
+        REQUIRE(array != list);
+        REQUIRE(list != deque);
+        REQUIRE_FALSE(Sequences::Equal(array.SliceView(0, 998), array.SliceView(1, 999)));
+    }
+}
+
+TEST_CASE("Sequence equality") {
+    std::vector<std::string> words;
+    for (int i = 0; i < 300; i++) words.push_back("word" + std::to_string(i % 17));
+
+    SECTION("Same concrete types") {
+        ListSequence<std::string> list(words.data(), 300);
+        ListSequence<std::string> other(words.data(), 300);
+        UnrolledListSequence<std::string> unrolled(words.data(), 300);
+        UnrolledListSequence<std::string> otherUnrolled(words.data(), 300);
+        REQUIRE(list == other);
+        REQUIRE(unrolled == otherUnrolled);
+        other.At(299) = "changed";
+        otherUnrolled.AddToEnd("extra");
+        REQUIRE(list != other);
+        REQUIRE(unrolled != otherUnrolled);
+
+        long long values[] = {1, 2, 3, 1LL << 40};
+        ArraySequence<long long> longs(values, 4);
+        ArraySequence<long long> otherLongs(values, 4);
+        REQUIRE(longs == otherLongs);
+        otherLongs.MutableAt(3) = 0;
+        REQUIRE(longs != otherLongs);
+    }
+
+    SECTION("Mixed types") {
+        ListSequence<std::string> list(words.data(), 300);
+        UnrolledListSequence<std::string> unrolled(words.data(), 300);
+        DequeSequence<std::string> deque(words.data(), 300);
+        ImmutableArraySequence<std::string> immutable(words.data(), 300);
+        ImmutableListSequence<std::string> versions(words.data(), 300);
+        REQUIRE(list == unrolled);
+        REQUIRE(unrolled == immutable);
+        REQUIRE(immutable == deque);
+        REQUIRE(deque == versions);
+        REQUIRE(versions == list);
+        deque.At(150) = "changed";
+        REQUIRE(list != deque);
+        REQUIRE(deque != immutable);
+    }
+
+    SECTION("Shared storage compares equal without a walk") {
+        ArraySequence<double> array(std::vector<double>(1000, NAN).data(), 1000);
+        ArraySequence<double> copy = array;
+        REQUIRE(array == copy);
+        copy.MutableAt(0) = NAN;
+        REQUIRE(array != copy);
+
+        ImmutableArraySequence<std::string> immutable(words.data(), 300);
+        ImmutableArraySequence<std::string> immutableCopy = immutable;
+        ImmutableListSequence<std::string> versions(words.data(), 300);
+        ImmutableListSequence<std::string> versionsCopy = versions;
+        REQUIRE(immutable == immutableCopy);
+        REQUIRE(versions == versionsCopy);
+        std::unique_ptr<ISequence<std::string>> edited(versions.AddToFront("first"));
+        REQUIRE(*edited != versions);
+    }
+}
+
+TEST_CASE("Sequence hashes") {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), -500);
+
+    SECTION("Equal contents hash alike across types") {
+        ArraySequence<int> array(values.data(), 1000);
+        ListSequence<int> list(values.data(), 1000);
+        UnrolledListSequence<int> unrolled(values.data(), 1000);
+        DequeSequence<int> deque(values.data(), 1000);
+        ImmutableArraySequence<int> immutable(values.data(), 1000);
+        ImmutableListSequence<int> versions(values.data(), 1000);
+        REQUIRE(array.Hash() == list.Hash());
+        REQUIRE(list.Hash() == unrolled.Hash());
+        REQUIRE(unrolled.Hash() == deque.Hash());
+        REQUIRE(deque.Hash() == immutable.Hash());
+        REQUIRE(immutable.Hash() == versions.Hash());
+        REQUIRE(array.Hash() != ArraySequence<int>(values.data(), 999).Hash());
+        std::swap(values[0], values[1]);
+        REQUIRE(array.Hash() != ArraySequence<int>(values.data(), 1000).Hash());
+
+        double zeros[] = {0.0, 1.5, -2.25};
+        double negativeZeros[] = {-0.0, 1.5, -2.25};
+        REQUIRE(ArraySequence<double>(zeros, 3).Hash() == ListSequence<double>(negativeZeros, 3).Hash());
+
+        std::string words[] = {"alpha", "beta", "gamma"};
+        REQUIRE(ArraySequence<std::string>(words, 3).Hash() == ListSequence<std::string>(words, 3).Hash());
+        REQUIRE(ArraySequence<std::string>(words, 3).Hash() != ArraySequence<std::string>(words + 1, 2).Hash());
+
+        User people[] = {User("Ann", 30), User("Bob", 25)};
+        ArraySequence<User> users(people, 2);
+        ListSequence<User> userList(people, 2);
+        REQUIRE(users.Hash() == userList.Hash());
+        userList.At(1).id = 7;
+        REQUIRE(users.Hash() != userList.Hash());
+    }
+
+    SECTION("Hashes follow writes") {
+        ArraySequence<int> array(values.data(), 1000);
+        ArraySequence<int> copy = array;
+        std::uint64_t original = array.Hash();
+        array.MutableAt(10) = 0;
+        REQUIRE(array.Hash() != original);
+        REQUIRE(copy.Hash() == original);
+        array.MutableAt(10) = values[10];
+        REQUIRE(array.Hash() == original);
+        array.AddToEnd(1);
+        REQUIRE(array.Hash() != original);
+        array.Delete(1000);
+        REQUIRE(array.Hash() == original);
+        array.Sort(std::greater<>());
+        REQUIRE(array.Hash() != original);
+
+        ArraySequence<int> moved = std::move(copy);
+        REQUIRE(moved.Hash() == original);
+        REQUIRE(copy.Hash() == ArraySequence<int>().Hash());
+
+        ImmutableListSequence<int> versions(values.data(), 1000);
+        std::uint64_t first = versions.Hash();
+        std::unique_ptr<ISequence<int>> edited(versions.AddToEnd(0));
+        REQUIRE(edited->Hash() != first);
+        REQUIRE(versions.Hash() == first);
+    }
+
+    SECTION("Writes through a reference held across Hash() are seen") {
+        int items[] = {1, 2, 3};
+        ArraySequence<int> left(items, 3);
+        ArraySequence<int> right(items, 3);
+        int& first = left.MutableAt(0);
+        first = 5;
+        std::uint64_t edited = left.Hash();
+        right.Hash();
+        first = 1;
+        REQUIRE(left == right);
+        REQUIRE(left.Hash() == right.Hash());
+        REQUIRE(left.Hash() != edited);
+    }
+
+    SECTION("Known hashes reject unequal immutable sequences") {
+        ImmutableArraySequence<int> left(values.begin(), values.end());
+        std::unique_ptr<ISequence<int>> right(left.Set(999, 0));
+        std::unique_ptr<ISequence<int>> restored(left.Set(999, values[999]));
+        left.Hash();
+        right->Hash();
+        restored->Hash();
+        REQUIRE(left != *right);
+        REQUIRE(left == *restored);
+    }
+}
+
+TEST_CASE("Chunked iteration") {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    ArraySequence<int> array(values.data(), 1000);
+    ListSequence<int> list(values.data(), 1000);
+    DequeSequence<int> deque(values.data(), 1000);
+    UnrolledListSequence<int> unrolled(values.data(), 1000);
+    ImmutableArraySequence<int> vector(values.begin(), values.end());
+    ImmutableListSequence<int> persistent(values.data(), 1000);
+    std::vector<const ISequence<int>*> sequences = {&array, &list, &deque, &unrolled, &vector, &persistent};
+
+    SECTION("Every sequence visits its elements in order") {
+        for (const ISequence<int>* seq : sequences) {
+            std::vector<int> seen;
+            int chunks = 0;
+            auto collect = [&](const int* items, int count) {
+                seen.insert(seen.end(), items, items + count);
+                chunks++;
+                return true;
+            };
+            REQUIRE(seq->ForEachChunk(ChunkVisitor<int>(collect)));
+            REQUIRE(seen == values);
+            REQUIRE(chunks <= 1000);
+        }
+    }
+
+    SECTION("Contiguous storage arrives in large runs") {
+        int chunks = 0;
+        auto count = [&](const int*, int) { return ++chunks > 0; };
+        array.ForEachChunk(ChunkVisitor<int>(count));
+        deque.ForEachChunk(ChunkVisitor<int>(count));
+        REQUIRE(chunks == 2);
+        chunks = 0;
+        unrolled.ForEachChunk(ChunkVisitor<int>(count));
+        REQUIRE(chunks < 100);
+    }
+
+    SECTION("Visitors stop early") {
+        for (const ISequence<int>* seq : sequences) {
+            int visited = 0;
+            int last = 0;
+            auto stop = [&](const int*, int count) {
+                visited += count;
+                last = count;
+                return visited < 10;
+            };
+            REQUIRE_FALSE(seq->ForEachChunk(ChunkVisitor<int>(stop)));
+            REQUIRE(visited - last < 10);
+            REQUIRE(Sequences::IndexOf(*seq, 500) == 500);
+            REQUIRE(Sequences::Sum(*seq) == 499500);
+        }
+    }
+
+    SECTION("ForEach and equality across sequence types") {
+        long long total = 0;
+        list.ForEach([&](int item) { total += item; });
+        REQUIRE(total == 499500);
+        REQUIRE(array == list);
+        REQUIRE(unrolled == vector);
+        REQUIRE(deque == persistent);
+        array.MutableAt(999) = -1;
+        REQUIRE(array != list);
+    }
+}
+
+TEST_CASE("Functional operations") {
+    SECTION("Map, Where, Zip and FlatMap keep the sequence kind") {
+        int items[] = {1, 2, 3, 4};
+        ArraySequence<int> array(items, 4);
+        ListSequence<int> list(items, 4);
+        ArraySequence<std::string> names = Sequences::Map(array, [](int item) { return std::to_string(item); });
+        ListSequence<int> evens = Sequences::Where(list, [](int item) { return item % 2 == 0; });
+        REQUIRE(names.At(3) == "4");
+        REQUIRE(evens.Size() == 2);
+        REQUIRE(evens.Back() == 4);
+
+        auto pairs = Sequences::Zip(array, names);
+        REQUIRE(pairs.Size() == 4);
+        REQUIRE(pairs.At(1) == std::make_pair(2, std::string("2")));
+        auto sums = Sequences::Zip(list, evens, [](int left, int right) { return left + right; });
+        REQUIRE(sums.Size() == 2);
+        REQUIRE(sums.At(1) == 6);
+
+        const ISequence<int>& seq = list;
+        ArraySequence<int> repeated = Sequences::FlatMap(seq, [](int item) { return std::vector<int>(item, item); });
+        REQUIRE(repeated.Size() == 10);
+        REQUIRE(Sequences::CountIf(repeated, [](int item) { return item == 3; }) == 3);
+        REQUIRE(Sequences::Reduce(seq, 0, [](int sum, int item) { return sum + item; }) == 10);
+    }
+
+    SECTION("Map keeps the list storage and builds values in place") {
+        int items[] = {1, 2, 3};
+        UnrolledListSequence<int> unrolled(items, 3);
+        ListSequence<int, LinkedList<int, HeapNodeAllocator>> heap(items, 3);
+        UnrolledListSequence<std::string> words = Sequences::Map(unrolled, [](int item) { return std::to_string(item); });
+        ListSequence<long long, LinkedList<long long, HeapNodeAllocator>> wide =
+            Sequences::Map(heap, [](int item) { return static_cast<long long>(item) << 40; });
+        REQUIRE(words.Back() == "3");
+        REQUIRE(wide.Front() == 1LL << 40);
+
+        ArraySequence<int> array(items, 3);
+        Tracked::copies = Tracked::moves = 0;
+        ArraySequence<Tracked> tracked = Sequences::Map(array, [](int item) { return Tracked(item * 10); });
+        REQUIRE(tracked.At(2).value == 30);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+
+    SECTION("Parallel policies match sequenced results") {
+        const int size = 100000;
+        std::vector<int> values(size);
+        std::iota(values.begin(), values.end(), 0);
+        ArraySequence<int> array(values.data(), size);
+        ListSequence<int> list(values.data(), size);
+        Execution::ParallelPolicy parallel{4};
+        auto square = [](int item) { return static_cast<long long>(item) * item; };
+        auto odd = [](int item) { return item % 2 == 1; };
+        auto add = [](long long sum, long long item) { return sum + item; };
+
+        REQUIRE(Sequences::Map(array, square, parallel) == Sequences::Map(array, square));
+        REQUIRE(Sequences::Map(list, square, parallel) == Sequences::Map(list, square));
+        REQUIRE(Sequences::Where(list, odd, parallel) == Sequences::Where(list, odd));
+        REQUIRE(Sequences::Reduce(array, 0LL, add, 0LL, parallel) == 4999950000LL);
+        REQUIRE(Sequences::Reduce(list, 0LL, add, 0LL, parallel) == 4999950000LL);
+        REQUIRE(Sequences::Reduce(array, 5LL, add, 0LL, parallel) == 4999950005LL);
+        auto twice = [](int item) { return std::vector<int>{item, item}; };
+        REQUIRE(Sequences::FlatMap(array, twice, parallel) == Sequences::FlatMap(array, twice));
+        REQUIRE(Sequences::Zip(array, list, parallel) == Sequences::Zip(array, list));
+    }
+
+    SECTION("Exceptions from workers reach the caller") {
+        ArraySequence<int> array(100000);
+        auto fail = [](int) -> int { throw std::runtime_error("worker failed"); };
+        REQUIRE_THROWS_AS(Sequences::Map(array, fail, Execution::ParallelPolicy{4}), std::runtime_error);
+    }
+}
+
+TEST_CASE("Lazy pipelines") {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    ArraySequence<int> array(values.data(), 100);
+    ListSequence<int> list(values.data(), 100);
+
+    SECTION("Stages fuse into one pass") {
+        int visited = 0;
+        auto squares = Lazy(list)
+                           .Where([&](int item) { visited++; return item % 2 == 1; })
+                           .Map([](int item) { return std::to_string(item * item); })
+                           .Take(3);
+        REQUIRE(visited == 0);
+        ArraySequence<std::string> result = squares.ToArraySequence();
+        REQUIRE(result.Size() == 3);
+        REQUIRE(result.Back() == "25");
+        REQUIRE(visited == 6);
+        REQUIRE(squares.ToListSequence().Front() == "1");
+    }
+
+    SECTION("Slice and Combine match the eager operations") {
+        std::unique_ptr<ISequence<int>> slice(array.Slice(10, 19));
+        std::unique_ptr<ISequence<int>> combined(slice->Combine(&list));
+        auto lazy = Lazy(array).Slice(10, 19).Combine(list);
+        REQUIRE(lazy.ToArraySequence() == *combined);
+        REQUIRE(lazy.Count() == 110);
+        REQUIRE(Lazy(array).Slice(95, 200).Count() == 5);
+        REQUIRE(lazy.Take(0).Count() == 0);
+        REQUIRE_THROWS_AS(Lazy(array).Slice(5, 4), std::out_of_range);
+    }
+
+    SECTION("Reductions stop pulling early") {
+        int visited = 0;
+        const ISequence<int>& seq = list;
+        int sum = Lazy(seq)
+                      .Map([&](int item) { visited++; return item * 2; })
+                      .Combine(Lazy(array).Skip(98))
+                      .Take(12)
+                      .Reduce(0, [](int total, int item) { return total + item; });
+        REQUIRE(sum == 132);
+        REQUIRE(visited == 12);
+        std::string joined;
+        Lazy(array).Skip(97).ForEach([&](int item) { joined += std::to_string(item); });
+        REQUIRE(joined == "979899");
+    }
+}
+
+TEST_CASE("Sorting") {
+    std::vector<int> values(100000);
+    std::uint32_t state = 12345;
+    for (int& value : values) {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<int>(state >> 8) % 5000 - 2500;
+    }
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    auto byAge = [](const User& left, const User& right) { return left.age < right.age; };
+    User users[] = {{"Dan", 40}, {"Ann", 30}, {"Bob", 40}, {"Cid", 30}, {"Eve", 20}};
+    User byAgeStable[] = {{"Eve", 20}, {"Ann", 30}, {"Cid", 30}, {"Dan", 40}, {"Bob", 40}};
+
+    SECTION("Contiguous sequences sort in place, in parallel if asked") {
+        ArraySequence<int> array(values.data(), 100000);
+        ArraySequence<int> parallel(values.data(), 100000);
+        DequeSequence<int> deque(values.data(), 100000);
+        ISequence<int>& seq = array;
+        REQUIRE(seq.Sort() == &seq);
+        parallel.StableSort(std::less<>(), Execution::ParallelPolicy{4});
+        deque.Sort(std::greater<>(), Execution::ParallelPolicy{3});
+        REQUIRE(std::equal(array.begin(), array.end(), sorted.begin()));
+        REQUIRE(std::equal(parallel.begin(), parallel.end(), sorted.begin()));
+        REQUIRE(std::equal(deque.begin(), deque.end(), sorted.rbegin()));
+
+        ArraySequence<User> people(users, 5);
+        ISequence<User>& peopleSeq = people;
+        peopleSeq.StableSort(byAge);
+        REQUIRE(people == ArraySequence<User>(byAgeStable, 5));
+    }
+
+    SECTION("List sort relinks nodes without moving elements") {
+        ListSequence<int> list(values.data(), 100000);
+        const int* smallest = &list.At(static_cast<int>(std::min_element(values.begin(), values.end()) - values.begin()));
+        list.Sort();
+        REQUIRE(std::equal(list.begin(), list.end(), sorted.begin()));
+        REQUIRE(&list.Front() == smallest);
+        list.AddToEnd(9999);
+        REQUIRE(list.Back() == 9999);
+
+        ListSequence<User> people(users, 5);
+        UnrolledListSequence<User> unrolled(users, 5);
+        static_cast<ISequence<User>&>(people).Sort(byAge);
+        unrolled.StableSort(byAge);
+        REQUIRE(people == ArraySequence<User>(byAgeStable, 5));
+        REQUIRE(unrolled == ArraySequence<User>(byAgeStable, 5));
+    }
+
+    SECTION("Radix sort for arithmetic elements and keys") {
+        std::vector<double> doubles;
+        for (int value : values) doubles.push_back(value / 7.0);
+        doubles[10] = -0.0;
+        doubles[20] = 0.0;
+        doubles[30] = -1e300;
+        doubles[40] = 1e300;
+        ArraySequence<double> array(doubles.data(), static_cast<int>(doubles.size()));
+        static_cast<ISequence<double>&>(array).StableSort();
+        std::stable_sort(doubles.begin(), doubles.end());
+        REQUIRE(std::equal(array.begin(), array.end(), doubles.begin()));
+        REQUIRE(std::signbit(array.At(static_cast<int>(std::lower_bound(doubles.begin(), doubles.end(), 0.0) - doubles.begin()))));
+
+        std::vector<unsigned long long> wide = {~0ULL, 0, 1ULL << 40, 7};
+        wide.resize(2000, 1ULL << 63);
+        ArraySequence<unsigned long long> unsignedArray(wide.data(), 2000);
+        unsignedArray.Sort();
+        REQUIRE(std::is_sorted(unsignedArray.begin(), unsignedArray.end()));
+        REQUIRE(unsignedArray.Back() == ~0ULL);
+
+        std::vector<User> crowd;
+        for (int i = 0; i < 3000; i++) {
+            crowd.emplace_back("u" + std::to_string(i), values[i] % 100 + 100);
+            crowd.back().id = 3000 - i;
+        }
+        ArraySequence<User> byKey(crowd.data(), 3000);
+        byKey.SortBy(&User::age);
+        std::stable_sort(crowd.begin(), crowd.end(), [](const User& left, const User& right) { return left.age < right.age; });
+        REQUIRE(std::equal(byKey.begin(), byKey.end(), crowd.begin()));
+        byKey.SortBy([](const User& user) { return user.id; });
+        REQUIRE(byKey.Front().id == 1);
+        REQUIRE(byKey.Back().name == "u0");
+    }
+
+    SECTION("Immutable sequences return a sorted copy") {
+        ImmutableArraySequence<int> array(values.begin(), values.end());
+        ImmutableListSequence<User> people(users, 5);
+        std::unique_ptr<ISequence<int>> sortedArray(array.Sort());
+        std::unique_ptr<ISequence<User>> sortedPeople(people.StableSort(byAge));
+        REQUIRE(std::equal(sortedArray->begin(), sortedArray->end(), sorted.begin()));
+        REQUIRE(array.At(0) == values[0]);
+        REQUIRE(*sortedPeople == ArraySequence<User>(byAgeStable, 5));
+        REQUIRE(people.Front().name == "Dan");
+    }
+}
+
 TEST_CASE("User type operations") {
     SECTION("User comparison") {
         User u1("Alice", 25);